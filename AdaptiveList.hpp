@@ -0,0 +1,491 @@
+/**
+ * @file AdaptiveList.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief List that switches between linked and contiguous storage by its operation mix
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _ADAPTIVE_LIST_HPP_
+#define _ADAPTIVE_LIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "List.hpp"
+
+/// Thresholds for AdaptiveList, measured in iterator steps per costly edit.
+struct AdaptivePolicy {
+  /// go contiguous when there are more steps than this per middle/front edit
+  double to_contiguous = 64.0;
+  /// go back to linked below this ratio, keep it under to_contiguous for hysteresis
+  double to_linked = 8.0;
+  /// steps + edits between two decisions
+  std::size_t window = 4096;
+  /// smaller containers stay as they are, converting them gains nothing
+  std::size_t min_size = 64;
+};
+
+/**
+ * @brief Container with the interface of List that stores its elements either in a List
+ * or in a std::vector and picks one from the observed operation mix.
+ *
+ * Iterator increments/decrements count as steps, insert/erase anywhere but the back
+ * count as edits (front and middle edits are what a vector is bad at). After every
+ * policy.window events the ratio steps/edits is compared against the policy and the
+ * storage is converted if it crosses a threshold, the gap between the thresholds keeps
+ * a mixed workload from flipping back and forth.
+ *
+ * Iterator invalidation:
+ * - A conversion only happens inside a modifying call (insert, emplace, push, pop, erase),
+ *   never while iterating, and it invalidates every iterator and reference. The iterator
+ *   returned by that call is valid.
+ * - Linked storage: like List, only iterators to erased elements are invalidated.
+ * - Contiguous storage: like std::vector, insert/erase/push_back invalidate iterators at
+ *   and after the position (all of them on reallocation), push_front/pop_front all of them.
+ * is_contiguous() tells which rules apply right now.
+ *
+ * Steps are counted even through const iterators, so concurrent readers need external
+ * synchronisation too.
+ *
+ * @tparam T Value type.
+ * @tparam Allocator Allocator used by both representations.
+ */
+template <class T, class Allocator = std::allocator<T>>
+class AdaptiveList {
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+ private:
+  using list_type = List<T, Allocator>;
+  using vector_type = std::vector<T, Allocator>;
+
+  list_type linked;
+  vector_type contiguous;
+  bool is_vec = false;
+  AdaptivePolicy policy;
+  mutable std::size_t steps = 0;
+  std::size_t edits = 0;
+
+ public:
+  /// iterator
+  template <bool _is_const>
+  class common_iterator {
+    friend class AdaptiveList;
+    template <bool>
+    friend class common_iterator;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::conditional_t<_is_const, const T, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<_is_const, const T*, T*>;
+    using reference = std::conditional_t<_is_const, const T&, T&>;
+
+   private:
+    using owner_pointer = std::conditional_t<_is_const, const AdaptiveList*, AdaptiveList*>;
+    using list_iterator =
+        std::conditional_t<_is_const, typename list_type::const_iterator, typename list_type::iterator>;
+
+    owner_pointer owner = nullptr;
+    list_iterator lit;     // linked storage
+    pointer vit = nullptr;  // contiguous storage
+
+    common_iterator(owner_pointer o, list_iterator it) : owner(o), lit(it) {}
+    common_iterator(owner_pointer o, pointer p) : owner(o), vit(p) {}
+
+   public:
+    common_iterator() = default;
+
+    reference operator*() const { return owner->is_vec ? *vit : *lit; }
+    pointer operator->() const { return &**this; }
+    bool operator==(const common_iterator& other) const {
+      return owner->is_vec ? vit == other.vit : lit == other.lit;
+    }
+    bool operator!=(const common_iterator& other) const { return !(*this == other); }
+    common_iterator& operator++() {
+      ++owner->steps;
+      if (owner->is_vec) {
+        ++vit;
+      } else {
+        ++lit;
+      }
+      return *this;
+    }
+    common_iterator operator++(int) {
+      common_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+    common_iterator& operator--() {
+      ++owner->steps;
+      if (owner->is_vec) {
+        --vit;
+      } else {
+        --lit;
+      }
+      return *this;
+    }
+    common_iterator operator--(int) {
+      common_iterator ret = *this;
+      --*this;
+      return ret;
+    }
+
+    operator common_iterator<true>() const {
+      list_iterator it = lit;  // List's conversion is not const
+      common_iterator<true> ret(owner, vit);
+      ret.lit = it;
+      return ret;
+    }
+  };
+
+  using iterator = common_iterator<false>;
+  using const_iterator = common_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+ private:
+  /// index of pos in the current storage, O(1) contiguous, O(n) linked
+  size_type indexOf(const_iterator pos) const;
+  /// pos refers to the last element, edits there are cheap in both representations
+  bool atBack(const_iterator pos) const noexcept;
+  iterator atIndex(size_type index);
+
+  void toContiguous();
+  void toLinked();
+
+  /**
+   * @brief Count one event and, at the end of a window, convert when the mix crossed
+   * a threshold. pos is carried over a conversion.
+   * @param costly true for an edit that is not at the back.
+   */
+  const_iterator adapt(const_iterator pos, bool costly);
+
+ public:
+  // ctors
+  explicit AdaptiveList(const Allocator& allocator = Allocator());
+  explicit AdaptiveList(const AdaptivePolicy& p, const Allocator& allocator = Allocator());
+  AdaptiveList(const AdaptiveList& other);
+  AdaptiveList(AdaptiveList&& other) noexcept;
+
+  AdaptiveList& operator=(const AdaptiveList& other);
+  AdaptiveList& operator=(AdaptiveList&& other);
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  const_reverse_iterator rcbegin() const noexcept { return const_reverse_iterator(cend()); }
+  const_reverse_iterator rcend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+
+  iterator insert(const_iterator pos, const T& value);
+  iterator insert(const_iterator pos, T&& value);
+
+  template <class InputIt>
+  std::enable_if_t<std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category,
+                                         std::input_iterator_tag>,
+                   iterator>
+  insert(const_iterator pos, InputIt first, InputIt last);
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+
+  template <class... Args>
+  reference emplace_back(Args&&... args);
+
+  template <class... Args>
+  reference emplace_front(Args&&... args);
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  void pop_back();
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+  void pop_front();
+
+  reference front() noexcept { return is_vec ? contiguous.front() : linked.front(); }
+  const_reference front() const noexcept { return is_vec ? contiguous.front() : linked.front(); }
+  reference back() noexcept { return is_vec ? contiguous.back() : linked.back(); }
+  const_reference back() const noexcept { return is_vec ? contiguous.back() : linked.back(); }
+
+  size_t size() const noexcept { return is_vec ? contiguous.size() : linked.size(); }
+  bool empty() const noexcept { return size() == 0; }
+  void clear() noexcept;
+
+  /// current representation, decides which invalidation rules apply
+  bool is_contiguous() const noexcept { return is_vec; }
+  /// force a representation and start a new window, invalidates all iterators when it changes
+  void make_contiguous();
+  void make_linked();
+
+  const AdaptivePolicy& get_policy() const noexcept { return policy; }
+  void set_policy(const AdaptivePolicy& p) noexcept { policy = p; }
+};
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>::AdaptiveList(const Allocator& allocator) : linked(allocator), contiguous(allocator) {}
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>::AdaptiveList(const AdaptivePolicy& p, const Allocator& allocator)
+    : linked(allocator), contiguous(allocator), policy(p) {}
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>::AdaptiveList(const AdaptiveList& other)
+    : linked(other.linked), contiguous(other.contiguous), is_vec(other.is_vec), policy(other.policy) {}
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>::AdaptiveList(AdaptiveList&& other) noexcept
+    : linked(std::move(other.linked)),
+      contiguous(std::move(other.contiguous)),
+      is_vec(other.is_vec),
+      policy(other.policy) {}
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>& AdaptiveList<T, Allocator>::operator=(const AdaptiveList& other) {
+  if (this == &other) return *this;
+  linked = other.linked;
+  contiguous = other.contiguous;
+  is_vec = other.is_vec;
+  policy = other.policy;
+  steps = edits = 0;
+  return *this;
+}
+
+template <class T, class Allocator>
+AdaptiveList<T, Allocator>& AdaptiveList<T, Allocator>::operator=(AdaptiveList&& other) {
+  if (this == &other) return *this;
+  linked = std::move(other.linked);
+  contiguous = std::move(other.contiguous);
+  is_vec = other.is_vec;
+  policy = other.policy;
+  steps = edits = 0;
+  return *this;
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::begin() noexcept {
+  return is_vec ? iterator(this, contiguous.data()) : iterator(this, linked.begin());
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::const_iterator AdaptiveList<T, Allocator>::begin() const noexcept {
+  return cbegin();
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::const_iterator AdaptiveList<T, Allocator>::cbegin() const noexcept {
+  return is_vec ? const_iterator(this, contiguous.data()) : const_iterator(this, linked.cbegin());
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::end() noexcept {
+  return is_vec ? iterator(this, contiguous.data() + contiguous.size()) : iterator(this, linked.end());
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::const_iterator AdaptiveList<T, Allocator>::end() const noexcept {
+  return cend();
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::const_iterator AdaptiveList<T, Allocator>::cend() const noexcept {
+  return is_vec ? const_iterator(this, contiguous.data() + contiguous.size()) : const_iterator(this, linked.cend());
+}
+
+template <class T, class Allocator>
+typename AdaptiveList<T, Allocator>::size_type AdaptiveList<T, Allocator>::indexOf(const_iterator pos) const {
+  if (is_vec) return static_cast<size_type>(pos.vit - contiguous.data());
+  size_type i = 0;
+  for (auto it = linked.cbegin(); it != pos.lit; ++it) ++i;
+  return i;
+}
+
+template <class T, class Allocator>
+inline bool AdaptiveList<T, Allocator>::atBack(const_iterator pos) const noexcept {
+  if (empty()) return false;
+  if (is_vec) return pos.vit == contiguous.data() + contiguous.size() - 1;
+  return pos.lit == --linked.cend();
+}
+
+template <class T, class Allocator>
+typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::atIndex(size_type index) {
+  if (is_vec) return iterator(this, contiguous.data() + index);
+  auto it = linked.begin();
+  std::advance(it, index);
+  return iterator(this, it);
+}
+
+template <class T, class Allocator>
+void AdaptiveList<T, Allocator>::toContiguous() {
+  contiguous.clear();
+  contiguous.reserve(linked.size());
+  for (auto it = linked.begin(); it != linked.end(); ++it) contiguous.push_back(std::move(*it));
+  linked.clear();
+  is_vec = true;
+}
+
+template <class T, class Allocator>
+void AdaptiveList<T, Allocator>::toLinked() {
+  linked.clear();
+  for (auto it = contiguous.begin(); it != contiguous.end(); ++it) linked.push_back(std::move(*it));
+  contiguous.clear();
+  contiguous.shrink_to_fit();
+  is_vec = false;
+}
+
+template <class T, class Allocator>
+typename AdaptiveList<T, Allocator>::const_iterator AdaptiveList<T, Allocator>::adapt(const_iterator pos,
+                                                                                     bool costly) {
+  if (costly) ++edits;
+  if (steps + edits < policy.window) return pos;
+  const double ratio = static_cast<double>(steps) / static_cast<double>(edits ? edits : 1);
+  steps = edits = 0;
+  const bool convert = size() >= policy.min_size &&
+                       (is_vec ? ratio < policy.to_linked : ratio > policy.to_contiguous);
+  if (!convert) return pos;
+  const size_type index = indexOf(pos);
+  if (is_vec) {
+    toLinked();
+  } else {
+    toContiguous();
+  }
+  return atIndex(index);
+}
+
+template <class T, class Allocator>
+void AdaptiveList<T, Allocator>::make_contiguous() {
+  if (!is_vec) toContiguous();
+  steps = edits = 0;
+}
+
+template <class T, class Allocator>
+void AdaptiveList<T, Allocator>::make_linked() {
+  if (is_vec) toLinked();
+  steps = edits = 0;
+}
+
+template <class T, class Allocator>
+typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::erase(const_iterator pos) {
+  pos = adapt(pos, !atBack(pos));
+  if (is_vec) {
+    const auto index = pos.vit - contiguous.data();
+    contiguous.erase(contiguous.begin() + index);
+    return iterator(this, contiguous.data() + index);
+  }
+  return iterator(this, linked.erase(pos.lit));
+}
+
+template <class T, class Allocator>
+typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::erase(const_iterator first,
+                                                                              const_iterator last) {
+  // an empty range costs nothing in either representation, only a real erase counts
+  if (first != last && !atBack(first)) ++edits;  // counted, but no conversion with two positions in flight
+  if (is_vec) {
+    const auto index = first.vit - contiguous.data();
+    contiguous.erase(contiguous.begin() + index, contiguous.begin() + (last.vit - contiguous.data()));
+    return iterator(this, contiguous.data() + index);
+  }
+  return iterator(this, linked.erase(first.lit, last.lit));
+}
+
+template <class T, class Allocator>
+template <class... Args>
+typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::emplace(const_iterator pos,
+                                                                                Args&&... args) {
+  pos = adapt(pos, pos != cend());
+  if (is_vec) {
+    const auto index = pos.vit - contiguous.data();
+    contiguous.emplace(contiguous.begin() + index, std::forward<Args>(args)...);
+    return iterator(this, contiguous.data() + index);
+  }
+  // List has no emplace at a position, build the value first
+  return iterator(this, linked.insert(pos.lit, T(std::forward<Args>(args)...)));
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::insert(const_iterator pos,
+                                                                                      const T& value) {
+  return emplace(pos, value);
+}
+
+template <class T, class Allocator>
+inline typename AdaptiveList<T, Allocator>::iterator AdaptiveList<T, Allocator>::insert(const_iterator pos,
+                                                                                      T&& value) {
+  return emplace(pos, std::move(value));
+}
+
+template <class T, class Allocator>
+template <class InputIt>
+std::enable_if_t<std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category,
+                                       std::input_iterator_tag>,
+                 typename AdaptiveList<T, Allocator>::iterator>
+AdaptiveList<T, Allocator>::insert(const_iterator pos, InputIt first, InputIt last) {
+  pos = adapt(pos, pos != cend());
+  const size_type index = indexOf(pos);
+  if (is_vec) {
+    contiguous.insert(contiguous.begin() + index, first, last);
+  } else {
+    linked.insert(pos.lit, first, last);
+  }
+  return atIndex(index);
+}
+
+template <class T, class Allocator>
+template <class... Args>
+T& AdaptiveList<T, Allocator>::emplace_back(Args&&... args) {
+  adapt(cend(), false);
+  if (is_vec) return contiguous.emplace_back(std::forward<Args>(args)...);
+  return linked.emplace_back(std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator>
+template <class... Args>
+T& AdaptiveList<T, Allocator>::emplace_front(Args&&... args) {
+  return *emplace(cbegin(), std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator>
+void AdaptiveList<T, Allocator>::pop_back() {
+  adapt(cend(), false);
+  if (is_vec) {
+    contiguous.pop_back();
+  } else {
+    linked.pop_back();
+  }
+}
+
+template <class T, class Allocator>
+inline void AdaptiveList<T, Allocator>::pop_front() {
+  erase(cbegin());
+}
+
+template <class T, class Allocator>
+inline void AdaptiveList<T, Allocator>::clear() noexcept {
+  linked.clear();
+  contiguous.clear();
+}
+
+#endif  // _ADAPTIVE_LIST_HPP_
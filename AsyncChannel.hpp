@@ -0,0 +1,465 @@
+/**
+ * @file AsyncChannel.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Bounded coroutine channel on top of List, with simple executors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _ASYNC_CHANNEL_HPP_
+#define _ASYNC_CHANNEL_HPP_
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "List.hpp"
+
+/**
+ * @brief Fire-and-forget coroutine. Created suspended, started by Executor::spawn,
+ * the frame frees itself when the body returns.
+ */
+class Task {
+ public:
+  struct promise_type {
+    Task get_return_object() noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+  Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  Task& operator=(Task&&) = delete;
+  ~Task() {
+    if (handle) handle.destroy();  // never started
+  }
+
+  /// give up ownership of the not yet started coroutine
+  std::coroutine_handle<> release() noexcept { return std::exchange(handle, nullptr); }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+  std::coroutine_handle<promise_type> handle;
+};
+
+/// Where suspended coroutines are resumed.
+class Executor {
+ public:
+  virtual ~Executor() = default;
+  /// queue handle for resumption, may be called from any thread
+  virtual void schedule(std::coroutine_handle<> handle) = 0;
+  void spawn(Task task) { schedule(task.release()); }
+};
+
+/**
+ * @brief Single-threaded executor, everything runs inside run() on the calling thread.
+ * schedule() is thread-safe so other threads may still hand work to it.
+ */
+class InlineExecutor : public Executor {
+ public:
+  void schedule(std::coroutine_handle<> handle) override;
+
+  /// resume queued coroutines until the queue is empty
+  void run();
+
+ private:
+  std::mutex mtx;
+  List<std::coroutine_handle<>> queue;
+};
+
+/// Fixed pool of worker threads sharing one run queue.
+class ThreadPoolExecutor : public Executor {
+ public:
+  explicit ThreadPoolExecutor(std::size_t threads = std::thread::hardware_concurrency());
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+  ~ThreadPoolExecutor();
+
+  void schedule(std::coroutine_handle<> handle) override;
+
+  /// block until the run queue is empty and no worker is resuming a coroutine
+  void wait_idle();
+
+ private:
+  void work();
+
+  std::mutex mtx;
+  std::condition_variable cv_work;
+  std::condition_variable cv_idle;
+  List<std::coroutine_handle<>> queue;
+  std::size_t active = 0;
+  bool stop = false;
+  std::vector<std::thread> workers;
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer channel.
+ *
+ * Buffered values live in a List, batches are handed out with List::splice so pop_n
+ * does not copy or move values. A full channel suspends pushers (backpressure),
+ * an empty one suspends poppers. Woken coroutines are resumed on the executor
+ * given to the constructor, never inline under the channel lock.
+ *
+ * @tparam T Value type, must be move constructible.
+ */
+template <class T>
+class AsyncChannel {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+ private:
+  struct PopWaiter {
+    std::coroutine_handle<> handle;
+    List<T>* out;  // filled by the waker
+    size_type max;
+    size_type got;
+  };
+
+  struct PushWaiter {
+    std::coroutine_handle<> handle;
+    T* value;  // owned by the suspended coroutine frame
+    bool ok;
+  };
+
+  class PopAwaiter;
+  class PopNAwaiter;
+  class PushAwaiter;
+
+  /**
+   * @brief Take up to max items out of the buffer into out, then refill the buffer
+   * from blocked pushers. Called under the lock.
+   * @param wake Handles to schedule after unlock.
+   * @return size_type Number of items moved to out.
+   */
+  size_type takeLocked(List<T>& out, size_type max, List<std::coroutine_handle<>>& wake);
+
+  /// hand value to the first pop waiter, called under the lock
+  std::coroutine_handle<> handOffLocked(T& value);
+
+  /// schedule every handle in wake, called without the lock
+  void resumeAll(List<std::coroutine_handle<>>& wake);
+
+  Executor& exec;
+  const size_type cap;
+  std::mutex mtx;
+  List<T> buffer;
+  List<PopWaiter*> pop_waiters;
+  List<PushWaiter*> push_waiters;
+  bool closed = false;
+
+ public:
+  /**
+   * @param executor Executor that resumes coroutines woken by this channel.
+   * @param capacity Maximum number of buffered values, at least 1.
+   */
+  explicit AsyncChannel(Executor& executor, size_type capacity = 64);
+  AsyncChannel(const AsyncChannel&) = delete;
+  AsyncChannel& operator=(const AsyncChannel&) = delete;
+
+  /// co_await push(v) -> bool, suspends while full, false if the channel is closed
+  PushAwaiter push(T value);
+
+  /// co_await pop() -> std::optional<T>, suspends while empty, nullopt once closed and drained
+  PopAwaiter pop();
+
+  /**
+   * @brief co_await pop_n(out, n) -> size_type, appends 1..n values to the back of out
+   * by splicing buffered nodes. Returns 0 once the channel is closed and drained.
+   * out must outlive the co_await and must use the default allocator state.
+   */
+  PopNAwaiter pop_n(List<T>& out, size_type n);
+
+  /**
+   * @brief Non-blocking push, never suspends.
+   * @param value Moved from when the push succeeds, left untouched when it fails, so the
+   * caller can retry with the same object.
+   * @return bool false if the channel is full or closed.
+   */
+  bool try_push(T& value);
+  /// non-blocking pop, never suspends, empty if nothing is buffered
+  std::optional<T> try_pop();
+
+  /// wake every waiter, later pushes fail, pops drain what is left
+  void close();
+
+  size_type capacity() const noexcept { return cap; }
+  size_type size();
+};
+
+template <class T>
+class AsyncChannel<T>::PopNAwaiter {
+ public:
+  PopNAwaiter(AsyncChannel& channel, List<T>& out, size_type n)
+      : ch(channel), waiter{nullptr, &out, n ? n : 1, 0} {}
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> h);
+  size_type await_resume() const noexcept { return waiter.got; }
+
+ private:
+  AsyncChannel& ch;
+  PopWaiter waiter;
+};
+
+template <class T>
+class AsyncChannel<T>::PopAwaiter {
+ public:
+  explicit PopAwaiter(AsyncChannel& channel) : inner(channel, slot, 1) {}
+  PopAwaiter(const PopAwaiter&) = delete;  // inner points at slot
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> h) { return inner.await_suspend(h); }
+  std::optional<T> await_resume();
+
+ private:
+  List<T> slot;  // must be constructed before inner
+  PopNAwaiter inner;
+};
+
+template <class T>
+class AsyncChannel<T>::PushAwaiter {
+ public:
+  PushAwaiter(AsyncChannel& channel, T&& v) : ch(channel), value(std::move(v)) {}
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> h);
+  bool await_resume() const noexcept { return waiter.ok; }
+
+ private:
+  AsyncChannel& ch;
+  T value;
+  PushWaiter waiter{};
+};
+
+inline void InlineExecutor::schedule(std::coroutine_handle<> handle) {
+  std::lock_guard lock(mtx);
+  queue.push_back(handle);
+}
+
+inline void InlineExecutor::run() {
+  for (;;) {
+    std::coroutine_handle<> h;
+    {
+      std::lock_guard lock(mtx);
+      if (queue.empty()) return;
+      h = queue.front();
+      queue.pop_front();
+    }
+    h.resume();
+  }
+}
+
+inline ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threads) {
+  if (threads == 0) threads = 1;
+  workers.reserve(threads);
+  for (std::size_t i = 0; i != threads; ++i) workers.emplace_back(&ThreadPoolExecutor::work, this);
+}
+
+inline ThreadPoolExecutor::~ThreadPoolExecutor() {
+  {
+    std::lock_guard lock(mtx);
+    stop = true;
+  }
+  cv_work.notify_all();
+  for (auto& t : workers) t.join();
+}
+
+inline void ThreadPoolExecutor::schedule(std::coroutine_handle<> handle) {
+  {
+    std::lock_guard lock(mtx);
+    queue.push_back(handle);
+  }
+  cv_work.notify_one();
+}
+
+inline void ThreadPoolExecutor::wait_idle() {
+  std::unique_lock lock(mtx);
+  cv_idle.wait(lock, [this] { return queue.empty() && active == 0; });
+}
+
+inline void ThreadPoolExecutor::work() {
+  std::unique_lock lock(mtx);
+  for (;;) {
+    cv_work.wait(lock, [this] { return stop || !queue.empty(); });
+    if (queue.empty()) return;  // stop requested and nothing left
+    std::coroutine_handle<> h = queue.front();
+    queue.pop_front();
+    ++active;
+    lock.unlock();
+    h.resume();
+    lock.lock();
+    if (--active == 0 && queue.empty()) cv_idle.notify_all();
+  }
+}
+
+template <class T>
+AsyncChannel<T>::AsyncChannel(Executor& executor, size_type capacity)
+    : exec(executor), cap(capacity ? capacity : 1) {}
+
+template <class T>
+typename AsyncChannel<T>::size_type AsyncChannel<T>::takeLocked(List<T>& out, size_type max,
+                                                                List<std::coroutine_handle<>>& wake) {
+  size_type n = buffer.size();
+  if (max >= n) {
+    out.splice(out.end(), buffer);
+  } else {
+    n = max;
+    auto last = buffer.begin();
+    std::advance(last, max);
+    out.splice(out.end(), buffer, buffer.cbegin(), last);
+  }
+  while (buffer.size() < cap && !push_waiters.empty()) {
+    PushWaiter* w = push_waiters.front();
+    push_waiters.pop_front();
+    buffer.push_back(std::move(*w->value));
+    w->ok = true;
+    wake.push_back(w->handle);
+  }
+  return n;
+}
+
+template <class T>
+std::coroutine_handle<> AsyncChannel<T>::handOffLocked(T& value) {
+  PopWaiter* w = pop_waiters.front();
+  pop_waiters.pop_front();
+  w->out->push_back(std::move(value));
+  w->got = 1;
+  return w->handle;
+}
+
+template <class T>
+void AsyncChannel<T>::resumeAll(List<std::coroutine_handle<>>& wake) {
+  for (auto it = wake.begin(); it != wake.end(); ++it) exec.schedule(*it);
+}
+
+template <class T>
+bool AsyncChannel<T>::PopNAwaiter::await_suspend(std::coroutine_handle<> h) {
+  List<std::coroutine_handle<>> wake;
+  {
+    std::lock_guard lock(ch.mtx);
+    if (ch.buffer.empty() && !ch.closed) {
+      waiter.handle = h;
+      ch.pop_waiters.push_back(&waiter);
+      return true;  // this frame may be resumed as soon as the lock is released
+    }
+    waiter.got = ch.takeLocked(*waiter.out, waiter.max, wake);
+  }
+  ch.resumeAll(wake);
+  return false;
+}
+
+template <class T>
+std::optional<T> AsyncChannel<T>::PopAwaiter::await_resume() {
+  if (slot.empty()) return std::nullopt;
+  return std::optional<T>(std::move(slot.front()));
+}
+
+template <class T>
+bool AsyncChannel<T>::PushAwaiter::await_suspend(std::coroutine_handle<> h) {
+  std::coroutine_handle<> wake;
+  {
+    std::lock_guard lock(ch.mtx);
+    if (ch.closed) {
+      waiter.ok = false;
+      return false;
+    }
+    waiter.ok = true;
+    if (!ch.pop_waiters.empty()) {
+      // the buffer is empty when someone waits on it, hand the value over directly
+      wake = ch.handOffLocked(value);
+    } else if (ch.buffer.size() < ch.cap) {
+      ch.buffer.push_back(std::move(value));
+    } else {
+      waiter.handle = h;
+      waiter.value = &value;
+      ch.push_waiters.push_back(&waiter);
+      return true;
+    }
+  }
+  if (wake) ch.exec.schedule(wake);
+  return false;
+}
+
+template <class T>
+inline typename AsyncChannel<T>::PushAwaiter AsyncChannel<T>::push(T value) {
+  return PushAwaiter(*this, std::move(value));
+}
+
+template <class T>
+inline typename AsyncChannel<T>::PopAwaiter AsyncChannel<T>::pop() {
+  return PopAwaiter(*this);
+}
+
+template <class T>
+inline typename AsyncChannel<T>::PopNAwaiter AsyncChannel<T>::pop_n(List<T>& out, size_type n) {
+  return PopNAwaiter(*this, out, n);
+}
+
+template <class T>
+bool AsyncChannel<T>::try_push(T& value) {
+  std::coroutine_handle<> wake;
+  {
+    std::lock_guard lock(mtx);
+    if (closed) return false;
+    if (!pop_waiters.empty()) {
+      wake = handOffLocked(value);
+    } else if (buffer.size() < cap) {
+      buffer.push_back(std::move(value));
+    } else {
+      return false;
+    }
+  }
+  if (wake) exec.schedule(wake);
+  return true;
+}
+
+template <class T>
+std::optional<T> AsyncChannel<T>::try_pop() {
+  List<T> out;
+  List<std::coroutine_handle<>> wake;
+  {
+    std::lock_guard lock(mtx);
+    if (buffer.empty()) return std::nullopt;
+    takeLocked(out, 1, wake);
+  }
+  resumeAll(wake);
+  return std::optional<T>(std::move(out.front()));
+}
+
+template <class T>
+void AsyncChannel<T>::close() {
+  List<std::coroutine_handle<>> wake;
+  {
+    std::lock_guard lock(mtx);
+    if (closed) return;
+    closed = true;
+    // pop waiters only exist while the buffer is empty, they get nothing
+    for (auto it = pop_waiters.begin(); it != pop_waiters.end(); ++it) wake.push_back((*it)->handle);
+    pop_waiters.clear();
+    // blocked pushers fail, what is already buffered stays poppable
+    for (auto it = push_waiters.begin(); it != push_waiters.end(); ++it) {
+      (*it)->ok = false;
+      wake.push_back((*it)->handle);
+    }
+    push_waiters.clear();
+  }
+  resumeAll(wake);
+}
+
+template <class T>
+inline typename AsyncChannel<T>::size_type AsyncChannel<T>::size() {
+  std::lock_guard lock(mtx);
+  return buffer.size();
+}
+
+#endif  // _ASYNC_CHANNEL_HPP_
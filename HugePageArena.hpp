@@ -0,0 +1,221 @@
+/**
+ * @file HugePageArena.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Node arena backed by 2 MiB pages and an allocator for List on top of it
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _HUGE_PAGE_ARENA_HPP_
+#define _HUGE_PAGE_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/**
+ * @brief Bump allocator for small fixed-size objects (list nodes) carved out of 2 MiB chunks.
+ *
+ * Every chunk is 2 MiB aligned so it can be backed by a single huge page, which
+ * keeps a traversal over millions of nodes inside a few TLB entries.
+ * Freed slots go to a per size class free list and are reused before bumping.
+ * Memory is returned to the system only when the arena is destroyed.
+ * Not thread-safe, one arena is meant to serve one container.
+ */
+class HugePageArena {
+ public:
+  enum class Pages {
+    Normal,       ///< plain 4 KiB pages, baseline for comparison
+    Transparent,  ///< madvise(MADV_HUGEPAGE), kernel backs chunks with THP when it can
+    Explicit,     ///< MAP_HUGETLB from the reserved pool, falls back to Transparent
+  };
+
+  static constexpr std::size_t chunk_size = std::size_t(2) << 20;
+  static constexpr std::size_t granularity = 16;
+  static constexpr std::size_t max_slot = 512;  ///< allocate() passes larger requests to operator new
+
+  explicit HugePageArena(Pages pages = Pages::Transparent) noexcept : mode(pages) {}
+  HugePageArena(const HugePageArena&) = delete;
+  HugePageArena& operator=(const HugePageArena&) = delete;
+  ~HugePageArena();
+
+  /// true if a block of this size and alignment is served from the chunks
+  static constexpr bool fits(std::size_t size, std::size_t align) noexcept {
+    return size <= max_slot && align <= granularity;
+  }
+
+  void* allocate(std::size_t size);
+  void deallocate(void* ptr, std::size_t size) noexcept;
+
+  std::size_t chunks() const noexcept { return chunk_list.size(); }
+  /// chunks that were mapped with MAP_HUGETLB
+  std::size_t hugetlb_chunks() const noexcept { return hugetlb; }
+  Pages pages() const noexcept { return mode; }
+
+ private:
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  struct Chunk {
+    void* base;
+    std::size_t length;  // length of the mapping, may be larger than chunk_size
+  };
+
+  static constexpr std::size_t classes = max_slot / granularity;
+  static constexpr std::size_t classOf(std::size_t size) noexcept {
+    return size ? (size + granularity - 1) / granularity - 1 : 0;
+  }
+
+  /// map one more chunk and reset the bump pointer to it
+  void grow();
+
+  Pages mode;
+  FreeSlot* free_lists[classes] = {};
+  char* bump = nullptr;
+  char* bump_end = nullptr;
+  std::vector<Chunk> chunk_list;
+  std::size_t hugetlb = 0;
+};
+
+/**
+ * @brief Stateful allocator that serves single-object requests from a shared HugePageArena.
+ * Rebound copies share the arena, so List<T, HugePageAllocator<T>> allocates its
+ * _priv::Node<T> objects from it. Array requests fall back to operator new.
+ */
+template <class T>
+class HugePageAllocator {
+  template <class U>
+  friend class HugePageAllocator;
+
+ public:
+  using value_type = T;
+
+  /// a default constructed allocator owns a fresh arena
+  HugePageAllocator() : arena(std::make_shared<HugePageArena>()) {}
+  explicit HugePageAllocator(std::shared_ptr<HugePageArena> a) noexcept : arena(std::move(a)) {}
+  template <class U>
+  HugePageAllocator(const HugePageAllocator<U>& other) noexcept : arena(other.arena) {}
+
+  T* allocate(std::size_t n);
+  void deallocate(T* ptr, std::size_t n) noexcept;
+
+  const std::shared_ptr<HugePageArena>& get_arena() const noexcept { return arena; }
+
+  template <class U>
+  bool operator==(const HugePageAllocator<U>& other) const noexcept {
+    return arena == other.arena;
+  }
+  template <class U>
+  bool operator!=(const HugePageAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<HugePageArena> arena;
+};
+
+inline HugePageArena::~HugePageArena() {
+  for (const Chunk& c : chunk_list) {
+#ifdef __linux__
+    ::munmap(c.base, c.length);
+#else
+    ::operator delete(c.base, std::align_val_t(chunk_size));
+#endif
+  }
+}
+
+inline void HugePageArena::grow() {
+  chunk_list.reserve(chunk_list.size() + 1);  // no throw after the mapping exists
+  void* base = nullptr;
+  std::size_t length = chunk_size;
+#ifdef __linux__
+#ifdef MAP_HUGETLB
+  if (mode == Pages::Explicit) {
+    base = ::mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (base == MAP_FAILED) {
+      base = nullptr;  // no reserved huge pages, use THP instead
+    } else {
+      ++hugetlb;
+    }
+  }
+#endif
+  if (!base) {
+    // over-map so a 2 MiB aligned window can be cut out, THP needs the alignment
+    length = 2 * chunk_size;
+    void* raw = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) throw std::bad_alloc();
+    const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = (addr + chunk_size - 1) & ~(std::uintptr_t(chunk_size) - 1);
+    if (aligned != addr) ::munmap(raw, aligned - addr);
+    if (aligned + chunk_size != addr + length) {
+      ::munmap(reinterpret_cast<void*>(aligned + chunk_size), addr + length - aligned - chunk_size);
+    }
+    base = reinterpret_cast<void*>(aligned);
+    length = chunk_size;
+#ifdef MADV_HUGEPAGE
+    if (mode != Pages::Normal) ::madvise(base, length, MADV_HUGEPAGE);
+#endif
+#ifdef MADV_NOHUGEPAGE
+    if (mode == Pages::Normal) ::madvise(base, length, MADV_NOHUGEPAGE);
+#endif
+  }
+#else
+  base = ::operator new(chunk_size, std::align_val_t(chunk_size));
+#endif
+  chunk_list.push_back(Chunk{base, length});
+  bump = static_cast<char*>(base);
+  bump_end = bump + chunk_size;
+}
+
+inline void* HugePageArena::allocate(std::size_t size) {
+  if (size > max_slot) return ::operator new(size);
+  const std::size_t cls = classOf(size);
+  if (FreeSlot* slot = free_lists[cls]) {
+    free_lists[cls] = slot->next;
+    return slot;
+  }
+  const std::size_t slot_size = (cls + 1) * granularity;
+  if (static_cast<std::size_t>(bump_end - bump) < slot_size) grow();
+  void* ret = bump;
+  bump += slot_size;
+  return ret;
+}
+
+inline void HugePageArena::deallocate(void* ptr, std::size_t size) noexcept {
+  if (size > max_slot) {
+    ::operator delete(ptr, size);
+    return;
+  }
+  const std::size_t cls = classOf(size);
+  FreeSlot* slot = ::new (ptr) FreeSlot{free_lists[cls]};
+  free_lists[cls] = slot;
+}
+
+template <class T>
+T* HugePageAllocator<T>::allocate(std::size_t n) {
+  if (n == 1 && HugePageArena::fits(sizeof(T), alignof(T))) {
+    return static_cast<T*>(arena->allocate(sizeof(T)));
+  }
+  return std::allocator<T>().allocate(n);
+}
+
+template <class T>
+void HugePageAllocator<T>::deallocate(T* ptr, std::size_t n) noexcept {
+  if (n == 1 && HugePageArena::fits(sizeof(T), alignof(T))) {
+    arena->deallocate(ptr, sizeof(T));
+    return;
+  }
+  std::allocator<T>().deallocate(ptr, n);
+}
+
+#endif  // _HUGE_PAGE_ARENA_HPP_
@@ -32,11 +32,14 @@ struct BaseNode {
   /// remove a link from the chain of nodes
   void unhook() noexcept;
 
-  /// Swaps the fields in values a and b
+  /// Swaps the chains hooked to the roots a and b
   static void swap(BaseNode& a, BaseNode& b) noexcept;
 
   void initToThis() noexcept;
 
+  /// move the range [first, last) before <pos>, the range must not contain <pos>
+  static void transfer(BaseNode* pos, BaseNode* first, BaseNode* last) noexcept;
+
   // unsafe cast
 };
 
@@ -69,6 +72,9 @@ class List {
   using traits_node = std::allocator_traits<decltype(node_alloc)>;
   using traits_vtype = std::allocator_traits<Allocator>;
 
+  static constexpr bool move_assign_noexcept =
+      traits_node::propagate_on_container_move_assignment::value || traits_node::is_always_equal::value;
+
   /**
    * @brief Allocate memory for node before the current (ptr),
    * and changes all the corresponding pointers, then call constructor.
@@ -90,17 +96,29 @@ class List {
    */
   Node* eraseNode(Node* ptr);
 
+  /// take over all nodes of other in O(1), *this must be empty and share other's allocator
+  void steal(List& other) noexcept;
+
   size_t sz = 0;
 
  public:
   // ctors
   explicit List(const Allocator& allocator = Allocator());
   explicit List(const List& other);
-  explicit List(List&& other);
+  /// O(1), the allocator is copied so other stays usable
+  List(List&& other) noexcept;
 
   // asing move
   List& operator=(const List& other);
-  List& operator=(List&& other);
+  /**
+   * @brief Relinks other's nodes in O(1) when the allocator propagates or both
+   * allocators compare equal, otherwise moves element by element into nodes
+   * from this allocator. other is empty afterwards.
+   */
+  List& operator=(List&& other) noexcept(move_assign_noexcept);
+
+  /// O(1), the allocators must propagate on swap or compare equal
+  void swap(List& other) noexcept;
 
   // dctor
   ~List();
@@ -192,6 +210,19 @@ class List {
   reference back() noexcept;
   const_reference back() const noexcept;
 
+  /**
+   * @brief Transfer nodes from other list before pos without copying or moving values.
+   * The allocators of both lists must compare equal.
+   * No iterators are invalidated, iterators to moved elements now refer into *this.
+   *
+   * @param pos Element before which the nodes are inserted.
+   * @param other Source list (may be *this for the single element and range overloads).
+   */
+  void splice(const_iterator pos, List& other) noexcept;
+  void splice(const_iterator pos, List& other, const_iterator it) noexcept;
+  /// O(1) when other is *this, otherwise O(distance(first, last)) to keep size() in sync
+  void splice(const_iterator pos, List& other, const_iterator first, const_iterator last) noexcept;
+
   size_t size() const noexcept;
   bool empty() const noexcept;
   void clear() noexcept;
@@ -199,37 +230,56 @@ class List {
 
 namespace _priv {
 
-void BaseNode::hook(BaseNode* node) noexcept {
+inline void BaseNode::hook(BaseNode* node) noexcept {
   next = node;
   prev = node->prev;
   node->prev->next = this;
   node->prev = this;
 }
 
-void BaseNode::unhook() noexcept {
+inline void BaseNode::unhook() noexcept {
   prev->next = next;
   next->prev = prev;
   prev = nullptr;
   next = nullptr;
 }
 
-void BaseNode::swap(BaseNode& a, BaseNode& b) noexcept {
-  BaseNode* tmp;
-  tmp = (a.prev != &a) ? (a.prev) : (&b);     // "this" pointer fix
-  a.prev = (b.prev != &b) ? (b.prev) : (&a);  // "this" pointer fix
-  b.prev = tmp;
-
-  tmp = (a.next != &a) ? (a.next) : (&b);     // "this" pointer fix
-  a.next = (b.next != &b) ? (b.next) : (&a);  // "this" pointer fix
-  b.next = tmp;
-
-  //   std::swap(a.prev, b.prev);  // if point to "this" then UB
-  //   std::swap(a.next, b.next);  // if point to "this" then UB
+inline void BaseNode::swap(BaseNode& a, BaseNode& b) noexcept {
+  const bool a_empty = a.next == &a;
+  const bool b_empty = b.next == &b;
+  std::swap(a.prev, b.prev);
+  std::swap(a.next, b.next);
+  // an empty root points to itself, the first and last nodes point back to their root
+  if (b_empty) {
+    a.initToThis();
+  } else {
+    a.next->prev = &a;
+    a.prev->next = &a;
+  }
+  if (a_empty) {
+    b.initToThis();
+  } else {
+    b.next->prev = &b;
+    b.prev->next = &b;
+  }
 }
 
-void BaseNode::initToThis() noexcept {
+inline void BaseNode::initToThis() noexcept {
   prev = next = this;
 }
+
+inline void BaseNode::transfer(BaseNode* pos, BaseNode* first, BaseNode* last) noexcept {
+  if (first == last || pos == last) return;
+  BaseNode* const tail = last->prev;
+  // cut [first, tail] out of the source chain
+  first->prev->next = last;
+  last->prev = first->prev;
+  // link it in front of pos
+  first->prev = pos->prev;
+  tail->next = pos;
+  pos->prev->next = first;
+  pos->prev = tail;
+}
 }  // namespace _priv
 
 /*
@@ -287,15 +337,15 @@ List<T, Allocator>::Node* List<T, Allocator>::eraseNode(
 template <class T, class Allocator>
 List<T, Allocator>::List(const Allocator& allocator)
     : vtype_alloc(allocator),
-      node_alloc(typename std::allocator_traits<Allocator>::rebind_alloc<Node>()) {
+      node_alloc(typename std::allocator_traits<Allocator>::rebind_alloc<Node>(allocator)) {
   m_root.initToThis();
 }
 
 template <class T, class Allocator>
-List<T, Allocator>::List(const List& other) {
-  clear();
-  vtype_alloc = other.vtype_alloc;
-  node_alloc = typename std::allocator_traits<decltype(vtype_alloc)>::rebind_alloc<Node>();
+List<T, Allocator>::List(const List& other)
+    : vtype_alloc(traits_vtype::select_on_container_copy_construction(other.vtype_alloc)),
+      node_alloc(typename std::allocator_traits<Allocator>::rebind_alloc<Node>(vtype_alloc)) {
+  m_root.initToThis();
   try {
     insert(end(), other.cbegin(), other.cend());
   } catch (...) {
@@ -305,12 +355,16 @@ List<T, Allocator>::List(const List& other) {
 }
 
 template <class T, class Allocator>
-List<T, Allocator>::List(List&& other) {
-  clear();
-  vtype_alloc = std::move(other.vtype_alloc);
-  node_alloc = std::move(typename std::allocator_traits<decltype(vtype_alloc)>::rebind_alloc<Node>());
-  BaseNode::swap(m_root, other.m_root);
-  std::swap(sz, other.sz);
+void List<T, Allocator>::steal(List& other) noexcept {
+  BaseNode::transfer(&m_root, other.m_root.next, &other.m_root);
+  sz = other.sz;
+  other.sz = 0;
+}
+
+template <class T, class Allocator>
+List<T, Allocator>::List(List&& other) noexcept : vtype_alloc(other.vtype_alloc), node_alloc(other.node_alloc) {
+  m_root.initToThis();
+  steal(other);
 }
 
 template <class T, class Allocator>
@@ -319,7 +373,7 @@ List<T, Allocator>& List<T, Allocator>::operator=(const List& other) {
   if (&other.m_root == &this->m_root) return *this;
   clear();
   vtype_alloc = other.vtype_alloc;
-  node_alloc = typename std::allocator_traits<decltype(vtype_alloc)>::rebind_alloc<Node>();
+  node_alloc = typename std::allocator_traits<decltype(vtype_alloc)>::rebind_alloc<Node>(vtype_alloc);
   try {
     insert(end(), other.cbegin(), other.cend());
   } catch (...) {
@@ -330,14 +384,39 @@ List<T, Allocator>& List<T, Allocator>::operator=(const List& other) {
 }
 
 template <class T, class Allocator>
-List<T, Allocator>& List<T, Allocator>::operator=(List&& other) {
+List<T, Allocator>& List<T, Allocator>::operator=(List&& other) noexcept(move_assign_noexcept) {
   if (&other.m_root == &this->m_root) return *this;
   clear();
-  vtype_alloc = std::move(other.vtype_alloc);
-  node_alloc = std::move(typename std::allocator_traits<decltype(vtype_alloc)>::rebind_alloc<Node>());
+  if constexpr (traits_node::propagate_on_container_move_assignment::value) {
+    vtype_alloc = other.vtype_alloc;
+    node_alloc = other.node_alloc;
+  } else if (!(node_alloc == other.node_alloc)) {
+    // nodes must be freed by the allocator that made them, so move the values instead
+    for (auto it = other.begin(); it != other.end(); ++it) insertNode(static_cast<Node*>(&m_root), std::move(*it));
+    other.clear();
+    return *this;
+  }
+  steal(other);
+  return *this;
+}
+
+template <class T, class Allocator>
+void List<T, Allocator>::swap(List& other) noexcept {
+  if (&other.m_root == &this->m_root) return;
+  if constexpr (traits_node::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(vtype_alloc, other.vtype_alloc);
+    swap(node_alloc, other.node_alloc);
+  } else {
+    assert(node_alloc == other.node_alloc);
+  }
   BaseNode::swap(m_root, other.m_root);
   std::swap(sz, other.sz);
-  return *this;
+}
+
+template <class T, class Allocator>
+inline void swap(List<T, Allocator>& a, List<T, Allocator>& b) noexcept {
+  a.swap(b);
 }
 
 template <class T, class Allocator>
@@ -599,6 +678,36 @@ inline List<T, Allocator>::const_reference List<T, Allocator>::back()
   return static_cast<Node*>(m_root.prev)->value;
 }
 
+template <class T, class Allocator>
+inline void List<T, Allocator>::splice(const_iterator pos, List& other) noexcept {
+  if (&other == this || other.empty()) return;
+  BaseNode::transfer(const_cast<Node*>(pos.ptr), other.m_root.next, &other.m_root);
+  sz += other.sz;
+  other.sz = 0;
+}
+
+template <class T, class Allocator>
+inline void List<T, Allocator>::splice(const_iterator pos, List& other, const_iterator it) noexcept {
+  BaseNode* const node = const_cast<Node*>(it.ptr);
+  BaseNode* const p = const_cast<Node*>(pos.ptr);
+  if (node == &other.m_root || p == node || p == node->next) return;
+  BaseNode::transfer(p, node, node->next);
+  --other.sz;
+  ++sz;
+}
+
+template <class T, class Allocator>
+inline void List<T, Allocator>::splice(const_iterator pos, List& other, const_iterator first,
+                                       const_iterator last) noexcept {
+  if (first == last) return;
+  if (&other != this) {
+    const size_t n = static_cast<size_t>(std::distance(first, last));
+    other.sz -= n;
+    sz += n;
+  }
+  BaseNode::transfer(const_cast<Node*>(pos.ptr), const_cast<Node*>(first.ptr), const_cast<Node*>(last.ptr));
+}
+
 template <class T, class Allocator>
 inline size_t List<T, Allocator>::size() const noexcept {
   return sz;
@@ -0,0 +1,285 @@
+/**
+ * @file NodeCache.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Thread-affine node cache, frees on foreign threads go back to the owner in batches
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _NODE_CACHE_HPP_
+#define _NODE_CACHE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Per-thread caches of blocks of one size, for list nodes.
+ *
+ * Blocks are carved out of 64 KiB aligned slabs, the slab header names the cache that
+ * owns them. A thread allocates from its own cache without synchronisation. A block
+ * freed by its owner goes straight back to the local free list; a block freed by
+ * another thread is put into that thread's magazine for the owner, and a full magazine
+ * is pushed onto the owner's remote stack with one CAS. The owner takes the whole
+ * remote stack with one exchange when its local list runs dry. So a producer/consumer
+ * pair costs one atomic operation per magazine instead of a remote free per node, and
+ * the two threads never write the same cache line per node.
+ *
+ * A cache outlives its thread: on thread exit the magazines are flushed and the cache
+ * is handed to the next thread that starts using NodeCache, together with its blocks.
+ * Slabs are released at program exit. Containers using it must not be thread_local or
+ * static, their nodes would be freed after the thread state is gone.
+ *
+ * @tparam Size Block size.
+ * @tparam Align Block alignment.
+ */
+template <std::size_t Size, std::size_t Align>
+class NodeCache {
+ public:
+  static constexpr std::size_t slab_size = std::size_t(64) << 10;
+  static constexpr std::size_t magazine_size = 64;  ///< blocks per batch sent to the owner
+  static constexpr std::size_t magazines = 4;       ///< owners a thread batches for at once
+
+  static void* allocate();
+  static void deallocate(void* ptr) noexcept;
+
+  /// send the calling thread's partly filled magazines to their owners
+  static void flush() noexcept;
+
+  /// slabs allocated so far by all threads
+  static std::size_t slabs();
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  struct Cache {
+    Block* local = nullptr;  // owner thread only
+    alignas(64) std::atomic<Block*> remote = nullptr;
+  };
+
+  struct alignas(Align > 16 ? Align : 16) SlabHeader {
+    Cache* owner;
+  };
+
+  static constexpr std::size_t block_size =
+      ((Size > sizeof(Block) ? Size : sizeof(Block)) + alignof(Block) - 1) / alignof(Block) * alignof(Block);
+  static constexpr std::size_t first_block = sizeof(SlabHeader);
+  static constexpr std::size_t blocks_per_slab = (slab_size - first_block) / block_size;
+  static_assert(blocks_per_slab >= 16, "NodeCache is meant for small nodes");
+
+  /// blocks freed on this thread that belong to another cache
+  struct Magazine {
+    Cache* owner = nullptr;
+    Block* head = nullptr;
+    Block* tail = nullptr;
+    std::size_t count = 0;
+  };
+
+  struct ThreadState {
+    ThreadState();
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+    ~ThreadState();
+
+    Cache* cache;
+    Magazine mags[magazines];
+  };
+
+  /// every cache and slab ever made, and the caches left behind by exited threads
+  struct Registry {
+    ~Registry();
+
+    std::mutex mtx;
+    std::vector<std::unique_ptr<Cache>> caches;
+    std::vector<Cache*> abandoned;
+    std::vector<void*> slabs;
+  };
+
+  static Registry& registry() {
+    static Registry r;
+    return r;
+  }
+
+  static ThreadState& state() {
+    thread_local ThreadState s;
+    return s;
+  }
+
+  static Cache* ownerOf(void* ptr) noexcept {
+    const auto addr = reinterpret_cast<std::uintptr_t>(ptr) & ~(std::uintptr_t(slab_size) - 1);
+    return reinterpret_cast<SlabHeader*>(addr)->owner;
+  }
+
+  /// push the magazine onto its owner's remote stack and empty it
+  static void send(Magazine& mag) noexcept;
+
+  /// fill the local list from the remote stack or a new slab
+  static void refill(Cache* cache);
+};
+
+/**
+ * @brief Stateless allocator serving single-object requests from NodeCache, so
+ * List<T, NodeCacheAllocator<T>> allocates its _priv::Node<T> objects per thread.
+ * Array requests fall back to operator new.
+ */
+template <class T>
+class NodeCacheAllocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  NodeCacheAllocator() noexcept = default;
+  template <class U>
+  NodeCacheAllocator(const NodeCacheAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n);
+  void deallocate(T* ptr, std::size_t n) noexcept;
+
+  template <class U>
+  bool operator==(const NodeCacheAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const NodeCacheAllocator<U>&) const noexcept {
+    return false;
+  }
+
+ private:
+  using cache_type = NodeCache<sizeof(T), alignof(T)>;
+  static constexpr bool cached = alignof(T) <= 64 && sizeof(T) <= 2048;  // NodeCache wants >= 16 blocks per slab
+};
+
+template <std::size_t Size, std::size_t Align>
+NodeCache<Size, Align>::ThreadState::ThreadState() {
+  Registry& r = registry();
+  std::lock_guard lock(r.mtx);
+  if (!r.abandoned.empty()) {
+    cache = r.abandoned.back();
+    r.abandoned.pop_back();
+  } else {
+    r.caches.push_back(std::make_unique<Cache>());
+    cache = r.caches.back().get();
+  }
+}
+
+template <std::size_t Size, std::size_t Align>
+NodeCache<Size, Align>::ThreadState::~ThreadState() {
+  for (Magazine& mag : mags) send(mag);
+  Registry& r = registry();
+  std::lock_guard lock(r.mtx);
+  r.abandoned.push_back(cache);
+}
+
+template <std::size_t Size, std::size_t Align>
+NodeCache<Size, Align>::Registry::~Registry() {
+  for (void* slab : slabs) ::operator delete(slab, std::align_val_t(slab_size));
+}
+
+template <std::size_t Size, std::size_t Align>
+void NodeCache<Size, Align>::send(Magazine& mag) noexcept {
+  if (!mag.head) return;
+  Block* old = mag.owner->remote.load(std::memory_order_relaxed);
+  do {
+    mag.tail->next = old;
+  } while (!mag.owner->remote.compare_exchange_weak(old, mag.head, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+  mag.head = mag.tail = nullptr;
+  mag.count = 0;
+}
+
+template <std::size_t Size, std::size_t Align>
+void NodeCache<Size, Align>::refill(Cache* cache) {
+  // the owner takes the whole stack, pushers never pop, so there is no ABA
+  cache->local = cache->remote.exchange(nullptr, std::memory_order_acquire);
+  if (cache->local) return;
+
+  void* slab = ::operator new(slab_size, std::align_val_t(slab_size));
+  {
+    Registry& r = registry();
+    std::lock_guard lock(r.mtx);
+    try {
+      r.slabs.push_back(slab);
+    } catch (...) {
+      ::operator delete(slab, std::align_val_t(slab_size));
+      throw;
+    }
+  }
+  ::new (slab) SlabHeader{cache};
+  char* const base = static_cast<char*>(slab) + first_block;
+  Block* head = nullptr;
+  for (std::size_t i = blocks_per_slab; i != 0; --i) head = ::new (base + (i - 1) * block_size) Block{head};
+  cache->local = head;
+}
+
+template <std::size_t Size, std::size_t Align>
+void* NodeCache<Size, Align>::allocate() {
+  Cache* const cache = state().cache;
+  if (!cache->local) refill(cache);
+  Block* const block = cache->local;
+  cache->local = block->next;
+  return block;
+}
+
+template <std::size_t Size, std::size_t Align>
+void NodeCache<Size, Align>::deallocate(void* ptr) noexcept {
+  ThreadState& s = state();
+  Cache* const owner = ownerOf(ptr);
+  Block* const block = ::new (ptr) Block{nullptr};
+  if (owner == s.cache) {
+    block->next = s.cache->local;
+    s.cache->local = block;
+    return;
+  }
+  Magazine& mag = s.mags[(reinterpret_cast<std::uintptr_t>(owner) / alignof(Cache)) % magazines];
+  if (mag.owner != owner) {
+    send(mag);
+    mag.owner = owner;
+  }
+  block->next = mag.head;
+  mag.head = block;
+  if (!mag.tail) mag.tail = block;
+  if (++mag.count == magazine_size) send(mag);
+}
+
+template <std::size_t Size, std::size_t Align>
+void NodeCache<Size, Align>::flush() noexcept {
+  for (Magazine& mag : state().mags) send(mag);
+}
+
+template <std::size_t Size, std::size_t Align>
+std::size_t NodeCache<Size, Align>::slabs() {
+  Registry& r = registry();
+  std::lock_guard lock(r.mtx);
+  return r.slabs.size();
+}
+
+template <class T>
+T* NodeCacheAllocator<T>::allocate(std::size_t n) {
+  if constexpr (cached) {
+    if (n == 1) return static_cast<T*>(cache_type::allocate());
+  }
+  return std::allocator<T>().allocate(n);
+}
+
+template <class T>
+void NodeCacheAllocator<T>::deallocate(T* ptr, std::size_t n) noexcept {
+  if constexpr (cached) {
+    if (n == 1) {
+      cache_type::deallocate(ptr);
+      return;
+    }
+  }
+  std::allocator<T>().deallocate(ptr, n);
+}
+
+#endif  // _NODE_CACHE_HPP_
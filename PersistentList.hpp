@@ -0,0 +1,346 @@
+/**
+ * @file PersistentList.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Persistent singly linked list with shared immutable tails
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _PERSISTENT_LIST_HPP_
+#define _PERSISTENT_LIST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Copy-on-write list. Nodes are immutable once linked and are shared between
+ * copies through an atomic reference count, so copying a list (a snapshot) is O(1)
+ * and a snapshot may be handed to another thread while the original keeps changing.
+ *
+ * Modifications never touch shared nodes: push_front/pop_front are O(1), insert/erase
+ * copy the nodes in front of pos and share everything after it.
+ * Concurrent use of one PersistentList object still needs external synchronisation,
+ * different objects sharing nodes do not.
+ *
+ * @tparam T Value type.
+ * @tparam Allocator Allocator for T, rebound to the node type.
+ */
+template <class T, class Allocator = std::allocator<T>>
+class PersistentList {
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+ private:
+  struct Node {
+    std::atomic<size_t> refs;
+    Node* next;
+    T value;
+  };
+
+  Node* head = nullptr;
+  size_t sz = 0;
+  Allocator vtype_alloc;
+  typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_alloc;
+  using traits_node = std::allocator_traits<decltype(node_alloc)>;
+  using traits_vtype = std::allocator_traits<Allocator>;
+
+  /**
+   * @brief Allocate and construct a node with refs = 1 in front of next.
+   * Takes over one reference to next.
+   */
+  template <class... Args>
+  Node* makeNode(Node* next, Args&&... args);
+
+  static Node* retain(Node* ptr) noexcept;
+
+  /// drop one reference, frees the chain while counts drop to zero (iterative)
+  void release(Node* ptr) noexcept;
+
+ public:
+  /// forward iterator over immutable values
+  class const_iterator {
+    friend class PersistentList;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return ptr->value; }
+    pointer operator->() const { return &ptr->value; }
+    bool operator==(const const_iterator& other) const { return ptr == other.ptr; }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    const_iterator& operator++() {
+      ptr = ptr->next;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator ret = *this;
+      ptr = ptr->next;
+      return ret;
+    }
+
+   private:
+    explicit const_iterator(const Node* node) : ptr(node) {}
+    const Node* ptr = nullptr;
+  };
+  using iterator = const_iterator;
+
+  // ctors
+  explicit PersistentList(const Allocator& allocator = Allocator());
+  PersistentList(std::initializer_list<T> init, const Allocator& allocator = Allocator());
+  PersistentList(const PersistentList& other) noexcept;
+  PersistentList(PersistentList&& other) noexcept;
+
+  PersistentList& operator=(const PersistentList& other) noexcept;
+  PersistentList& operator=(PersistentList&& other) noexcept;
+
+  ~PersistentList();
+
+  const_iterator begin() const noexcept { return const_iterator(head); }
+  const_iterator cbegin() const noexcept { return const_iterator(head); }
+  const_iterator end() const noexcept { return const_iterator(); }
+  const_iterator cend() const noexcept { return const_iterator(); }
+
+  /// O(1) copy sharing every node
+  PersistentList snapshot() const noexcept { return *this; }
+
+  template <class... Args>
+  const_reference emplace_front(Args&&... args);
+  void push_front(const T& value);
+  void push_front(T&& value);
+  void pop_front() noexcept;
+
+  /**
+   * @brief Insert value before pos. Nodes in front of pos are copied,
+   * pos and everything after it stay shared.
+   * @return const_iterator Iterator to the inserted element.
+   */
+  const_iterator insert(const_iterator pos, const T& value);
+  const_iterator insert(const_iterator pos, T&& value);
+
+  /**
+   * @brief Remove the element at pos, copying the nodes in front of it.
+   * @return const_iterator Iterator to the element after the erased one.
+   */
+  const_iterator erase(const_iterator pos);
+
+  const_reference front() const noexcept { return head->value; }
+
+  size_t size() const noexcept { return sz; }
+  bool empty() const noexcept { return head == nullptr; }
+  void clear() noexcept;
+
+  /// true when both lists share the same first node (and so every element)
+  bool shares(const PersistentList& other) const noexcept { return head == other.head; }
+
+ private:
+  /**
+   * @brief Copy the nodes in front of pos and link the copy to tail.
+   * The old prefix stays intact for other owners.
+   * @param tail Node the copied prefix ends with, one reference is consumed.
+   * @return Node* Last copied node or nullptr when pos == begin().
+   */
+  Node* copyPrefix(const Node* pos, Node* tail);
+};
+
+template <class T, class Allocator>
+template <class... Args>
+typename PersistentList<T, Allocator>::Node* PersistentList<T, Allocator>::makeNode(Node* next,
+                                                                                      Args&&... args) {
+  Node* const newnode = traits_node::allocate(node_alloc, 1);
+  try {
+    traits_vtype::construct(vtype_alloc, &newnode->value, std::forward<Args>(args)...);
+  } catch (...) {
+    traits_node::deallocate(node_alloc, newnode, 1);
+    throw;
+  }
+  ::new (static_cast<void*>(&newnode->refs)) std::atomic<size_t>(1);
+  newnode->next = next;
+  return newnode;
+}
+
+template <class T, class Allocator>
+inline typename PersistentList<T, Allocator>::Node* PersistentList<T, Allocator>::retain(Node* ptr) noexcept {
+  if (ptr) ptr->refs.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+template <class T, class Allocator>
+void PersistentList<T, Allocator>::release(Node* ptr) noexcept {
+  while (ptr && ptr->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Node* next = ptr->next;
+    traits_vtype::destroy(vtype_alloc, &ptr->value);
+    ptr->refs.~atomic();
+    traits_node::deallocate(node_alloc, ptr, 1);
+    ptr = next;
+  }
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(const Allocator& allocator)
+    : vtype_alloc(allocator), node_alloc(allocator) {}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(std::initializer_list<T> init, const Allocator& allocator)
+    : PersistentList(allocator) {
+  Node* tail = nullptr;
+  try {
+    for (auto it = init.begin(); it != init.end(); ++it) {
+      Node* n = makeNode(nullptr, *it);
+      (tail ? tail->next : head) = n;
+      tail = n;
+      ++sz;
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(const PersistentList& other) noexcept
+    : head(retain(other.head)), sz(other.sz), vtype_alloc(other.vtype_alloc), node_alloc(other.node_alloc) {}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(PersistentList&& other) noexcept
+    : head(std::exchange(other.head, nullptr)),
+      sz(std::exchange(other.sz, 0)),
+      vtype_alloc(other.vtype_alloc),
+      node_alloc(other.node_alloc) {}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>& PersistentList<T, Allocator>::operator=(const PersistentList& other) noexcept {
+  if (this == &other) return *this;
+  Node* old = head;
+  head = retain(other.head);
+  sz = other.sz;
+  release(old);  // nodes may belong to the old allocator
+  vtype_alloc = other.vtype_alloc;
+  node_alloc = other.node_alloc;
+  return *this;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>& PersistentList<T, Allocator>::operator=(PersistentList&& other) noexcept {
+  if (this == &other) return *this;
+  clear();
+  head = std::exchange(other.head, nullptr);
+  sz = std::exchange(other.sz, 0);
+  vtype_alloc = other.vtype_alloc;
+  node_alloc = other.node_alloc;
+  return *this;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::~PersistentList() {
+  clear();
+}
+
+template <class T, class Allocator>
+template <class... Args>
+typename PersistentList<T, Allocator>::const_reference PersistentList<T, Allocator>::emplace_front(
+    Args&&... args) {
+  head = makeNode(head, std::forward<Args>(args)...);  // the old head reference moves into the node
+  ++sz;
+  return head->value;
+}
+
+template <class T, class Allocator>
+inline void PersistentList<T, Allocator>::push_front(const T& value) {
+  emplace_front(value);
+}
+
+template <class T, class Allocator>
+inline void PersistentList<T, Allocator>::push_front(T&& value) {
+  emplace_front(std::move(value));
+}
+
+template <class T, class Allocator>
+inline void PersistentList<T, Allocator>::pop_front() noexcept {
+  if (!head) return;
+  Node* old = head;
+  head = retain(head->next);
+  --sz;
+  release(old);
+}
+
+template <class T, class Allocator>
+typename PersistentList<T, Allocator>::Node* PersistentList<T, Allocator>::copyPrefix(const Node* pos,
+                                                                                     Node* tail) {
+  Node* first = nullptr;
+  Node* last = nullptr;
+  try {
+    for (const Node* p = head; p != pos; p = p->next) {
+      Node* n = makeNode(nullptr, p->value);
+      (last ? last->next : first) = n;
+      last = n;
+    }
+  } catch (...) {
+    release(first);
+    release(tail);
+    throw;
+  }
+  if (!last) {
+    release(head);
+    head = tail;
+    return nullptr;
+  }
+  last->next = tail;
+  release(head);
+  head = first;
+  return last;
+}
+
+template <class T, class Allocator>
+typename PersistentList<T, Allocator>::const_iterator PersistentList<T, Allocator>::insert(const_iterator pos,
+                                                                                         const T& value) {
+  Node* n = makeNode(nullptr, value);
+  n->next = retain(const_cast<Node*>(pos.ptr));
+  copyPrefix(pos.ptr, n);
+  ++sz;
+  return const_iterator(n);
+}
+
+template <class T, class Allocator>
+typename PersistentList<T, Allocator>::const_iterator PersistentList<T, Allocator>::insert(const_iterator pos,
+                                                                                         T&& value) {
+  Node* n = makeNode(nullptr, std::move(value));
+  n->next = retain(const_cast<Node*>(pos.ptr));
+  copyPrefix(pos.ptr, n);
+  ++sz;
+  return const_iterator(n);
+}
+
+template <class T, class Allocator>
+typename PersistentList<T, Allocator>::const_iterator PersistentList<T, Allocator>::erase(const_iterator pos) {
+  if (!pos.ptr) return pos;
+  Node* next = pos.ptr->next;
+  copyPrefix(pos.ptr, retain(next));
+  --sz;
+  return const_iterator(next);
+}
+
+template <class T, class Allocator>
+inline void PersistentList<T, Allocator>::clear() noexcept {
+  release(std::exchange(head, nullptr));
+  sz = 0;
+}
+
+#endif  // _PERSISTENT_LIST_HPP_
@@ -0,0 +1,376 @@
+/**
+ * @file RcuList.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Read-mostly list with lock-free readers and epoch based reclamation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _RCU_LIST_HPP_
+#define _RCU_LIST_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "List.hpp"
+
+/**
+ * @brief List for data that is read on every request and changed rarely.
+ *
+ * Nodes are _priv::Node<T> linked through _priv::BaseNode like in List. Readers only
+ * follow next pointers, loading them with acquire and never taking a lock or doing an
+ * atomic read-modify-write. Writers are serialised by a mutex, fully build a node
+ * before publishing it with a release store and never change the next pointer of an
+ * unlinked node, so a reader standing on it still finds its way back into the list.
+ *
+ * Unlinked nodes are retired with the current epoch and freed once every reader that
+ * could have seen them has left its critical section (epoch based reclamation).
+ * Each reading thread registers once through reader() and gets its own epoch slot.
+ *
+ * @tparam T Value type, readers only get const access.
+ * @tparam Allocator Allocator for T, rebound to the node type.
+ */
+template <class T, class Allocator = std::allocator<T>>
+class RcuList {
+  using BaseNode = _priv::BaseNode;
+  using Node = _priv::Node<T>;
+
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> epoch{0};  // 0 when not inside a read-side section
+    std::atomic<bool> used{false};
+  };
+
+  struct Retired {
+    Node* node;
+    std::uint64_t epoch;
+  };
+
+  BaseNode m_root;
+  std::mutex writer_mtx;
+  std::atomic<std::uint64_t> global_epoch{1};
+  std::unique_ptr<Slot[]> slots;
+  const size_t max_readers;
+  List<Retired> retired;  // guarded by writer_mtx, oldest first
+  std::atomic<size_t> sz{0};
+
+  Allocator vtype_alloc;
+  typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_alloc;
+  using traits_node = std::allocator_traits<decltype(node_alloc)>;
+  using traits_vtype = std::allocator_traits<Allocator>;
+
+  static BaseNode* loadNext(const BaseNode* node) noexcept {
+    return std::atomic_ref<BaseNode*>(const_cast<BaseNode*&>(node->next)).load(std::memory_order_acquire);
+  }
+  static void publishNext(BaseNode* node, BaseNode* next) noexcept {
+    std::atomic_ref<BaseNode*>(node->next).store(next, std::memory_order_release);
+  }
+
+  template <class... Args>
+  Node* makeNode(Args&&... args);
+  void freeNode(Node* ptr) noexcept;
+
+  /// build a node and publish it before pos, under writer_mtx
+  template <class... Args>
+  void linkBefore(BaseNode* pos, Args&&... args);
+
+  /// unlink ptr and retire it, under writer_mtx
+  void unlink(Node* ptr);
+
+  /**
+   * @brief Advance the epoch if no reader lags behind, then free nodes no reader can reach.
+   * Called under writer_mtx.
+   */
+  void reclaim() noexcept;
+
+ public:
+  class Reader;
+
+  /// forward iterator, only valid inside a read-side section
+  class const_iterator {
+    friend class RcuList;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+    reference operator*() const { return static_cast<const Node*>(ptr)->value; }
+    pointer operator->() const { return &static_cast<const Node*>(ptr)->value; }
+    bool operator==(const const_iterator& other) const { return ptr == other.ptr; }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    const_iterator& operator++() {
+      ptr = loadNext(ptr);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator ret = *this;
+      ptr = loadNext(ptr);
+      return ret;
+    }
+
+   private:
+    explicit const_iterator(const BaseNode* node) : ptr(node) {}
+    const BaseNode* ptr = nullptr;
+  };
+
+  /// read-side critical section, nodes seen inside it stay alive until it ends
+  class Guard {
+    friend class Reader;
+
+   public:
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+    ~Guard() { slot->epoch.store(0, std::memory_order_release); }
+
+    const_iterator begin() const noexcept { return const_iterator(loadNext(&list->m_root)); }
+    const_iterator end() const noexcept { return const_iterator(&list->m_root); }
+
+   private:
+    Guard(const RcuList* l, Slot* s) noexcept;
+    const RcuList* list;
+    Slot* slot;
+  };
+
+  /// per-thread reader registration, not to be shared between threads
+  class Reader {
+    friend class RcuList;
+
+   public:
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    ~Reader() { slot->used.store(false, std::memory_order_release); }
+
+    /// enter a read-side section, sections of one reader must not nest
+    Guard lock() const noexcept { return Guard(list, slot); }
+
+    /// call f(const T&) for every element inside one read-side section
+    template <class F>
+    void for_each(F&& f) const;
+
+   private:
+    Reader(const RcuList* l, Slot* s) noexcept : list(l), slot(s) {}
+    const RcuList* list;
+    Slot* slot;
+  };
+
+  /**
+   * @param readers Maximum number of simultaneously registered readers.
+   */
+  explicit RcuList(size_t readers = 64, const Allocator& allocator = Allocator());
+  RcuList(const RcuList&) = delete;
+  RcuList& operator=(const RcuList&) = delete;
+  /// no reader may be registered any more
+  ~RcuList();
+
+  /**
+   * @brief Register the calling thread as a reader.
+   * @throw std::length_error when all slots are taken.
+   */
+  Reader reader();
+
+  // writers, serialised internally
+  void push_back(const T& value);
+  void push_front(const T& value);
+  template <class... Args>
+  void emplace_back(Args&&... args);
+
+  /// erase every element matching pred, returns the number of erased elements
+  template <class Pred>
+  size_t erase_if(Pred pred);
+
+  /// replace the first element matching pred by value (insert, then erase the old one)
+  template <class Pred>
+  bool replace_if(Pred pred, const T& value);
+
+  void clear();
+
+  /// block until every retired node is freed, must not be called inside a read-side section
+  void synchronize();
+
+  size_t size() const noexcept { return sz.load(std::memory_order_relaxed); }
+  bool empty() const noexcept { return size() == 0; }
+};
+
+template <class T, class Allocator>
+RcuList<T, Allocator>::Guard::Guard(const RcuList* l, Slot* s) noexcept : list(l), slot(s) {
+  slot->epoch.store(list->global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  // order the announcement before any load of the list, pairs with the fence in reclaim()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+template <class T, class Allocator>
+template <class F>
+void RcuList<T, Allocator>::Reader::for_each(F&& f) const {
+  Guard g = lock();
+  for (auto it = g.begin(); it != g.end(); ++it) f(*it);
+}
+
+template <class T, class Allocator>
+RcuList<T, Allocator>::RcuList(size_t readers, const Allocator& allocator)
+    : slots(new Slot[readers ? readers : 1]),
+      max_readers(readers ? readers : 1),
+      vtype_alloc(allocator),
+      node_alloc(allocator) {
+  m_root.initToThis();
+}
+
+template <class T, class Allocator>
+RcuList<T, Allocator>::~RcuList() {
+  for (BaseNode* p = m_root.next; p != &m_root;) {
+    BaseNode* next = p->next;
+    freeNode(static_cast<Node*>(p));
+    p = next;
+  }
+  for (auto it = retired.begin(); it != retired.end(); ++it) freeNode(it->node);
+}
+
+template <class T, class Allocator>
+template <class... Args>
+typename RcuList<T, Allocator>::Node* RcuList<T, Allocator>::makeNode(Args&&... args) {
+  Node* const newnode = traits_node::allocate(node_alloc, 1);
+  try {
+    traits_vtype::construct(vtype_alloc, &newnode->value, std::forward<Args>(args)...);
+  } catch (...) {
+    traits_node::deallocate(node_alloc, newnode, 1);
+    throw;
+  }
+  return newnode;
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::freeNode(Node* ptr) noexcept {
+  traits_vtype::destroy(vtype_alloc, &ptr->value);
+  traits_node::deallocate(node_alloc, ptr, 1);
+}
+
+template <class T, class Allocator>
+template <class... Args>
+void RcuList<T, Allocator>::linkBefore(BaseNode* pos, Args&&... args) {
+  Node* node = makeNode(std::forward<Args>(args)...);
+  node->next = pos;
+  node->prev = pos->prev;
+  publishNext(pos->prev, node);  // readers may see the node from here on
+  pos->prev = node;              // prev is only used by writers
+  sz.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::unlink(Node* ptr) {
+  retired.push_back(Retired{ptr, 0});  // may throw, do it before touching the links
+  BaseNode* prev = ptr->prev;
+  BaseNode* next = ptr->next;
+  publishNext(prev, next);
+  next->prev = prev;
+  // ptr->next is left intact for readers still standing on ptr
+  retired.back().epoch = global_epoch.load(std::memory_order_relaxed);
+  sz.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::reclaim() noexcept {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const std::uint64_t current = global_epoch.load(std::memory_order_relaxed);
+  bool lagging = false;
+  for (size_t i = 0; i != max_readers; ++i) {
+    const std::uint64_t e = slots[i].epoch.load(std::memory_order_acquire);
+    if (e != 0 && e != current) {
+      lagging = true;
+      break;
+    }
+  }
+  if (!lagging) global_epoch.store(current + 1, std::memory_order_seq_cst);
+  const std::uint64_t safe = global_epoch.load(std::memory_order_relaxed);
+  // a node retired at epoch e is unreachable for every reader once the epoch moved twice
+  while (!retired.empty() && retired.front().epoch + 2 <= safe) {
+    freeNode(retired.front().node);
+    retired.pop_front();
+  }
+}
+
+template <class T, class Allocator>
+typename RcuList<T, Allocator>::Reader RcuList<T, Allocator>::reader() {
+  for (size_t i = 0; i != max_readers; ++i) {
+    bool expected = false;
+    if (!slots[i].used.load(std::memory_order_relaxed) &&
+        slots[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      return Reader(this, &slots[i]);
+    }
+  }
+  throw std::length_error("RcuList: too many readers");
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::push_back(const T& value) {
+  std::lock_guard lock(writer_mtx);
+  linkBefore(&m_root, value);
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::push_front(const T& value) {
+  std::lock_guard lock(writer_mtx);
+  linkBefore(m_root.next, value);
+}
+
+template <class T, class Allocator>
+template <class... Args>
+void RcuList<T, Allocator>::emplace_back(Args&&... args) {
+  std::lock_guard lock(writer_mtx);
+  linkBefore(&m_root, std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator>
+template <class Pred>
+size_t RcuList<T, Allocator>::erase_if(Pred pred) {
+  std::lock_guard lock(writer_mtx);
+  size_t n = 0;
+  for (BaseNode* p = m_root.next; p != &m_root;) {
+    BaseNode* next = p->next;
+    if (pred(static_cast<const Node*>(p)->value)) {
+      unlink(static_cast<Node*>(p));
+      ++n;
+    }
+    p = next;
+  }
+  reclaim();
+  return n;
+}
+
+template <class T, class Allocator>
+template <class Pred>
+bool RcuList<T, Allocator>::replace_if(Pred pred, const T& value) {
+  std::lock_guard lock(writer_mtx);
+  for (BaseNode* p = m_root.next; p != &m_root; p = p->next) {
+    if (pred(static_cast<const Node*>(p)->value)) {
+      // readers see either the old or the new element, or briefly both
+      linkBefore(p, value);
+      unlink(static_cast<Node*>(p));
+      reclaim();
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::clear() {
+  erase_if([](const T&) { return true; });
+}
+
+template <class T, class Allocator>
+void RcuList<T, Allocator>::synchronize() {
+  std::lock_guard lock(writer_mtx);
+  while (!retired.empty()) reclaim();
+}
+
+#endif  // _RCU_LIST_HPP_
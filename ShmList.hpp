@@ -0,0 +1,518 @@
+/**
+ * @file ShmList.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief List with offset pointers living in a POSIX shared memory segment
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _SHM_LIST_HPP_
+#define _SHM_LIST_HPP_
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Pointer stored as the distance from its own address, so it stays valid when
+ * the memory holding both it and its target is mapped at different addresses.
+ * Only meaningful for pointers between objects of the same mapping.
+ */
+template <class T>
+class OffsetPtr {
+ public:
+  OffsetPtr() noexcept = default;
+  OffsetPtr(T* ptr) noexcept { set(ptr); }  // NOLINT implicit like a raw pointer
+  OffsetPtr(const OffsetPtr& other) noexcept { set(other.get()); }
+  OffsetPtr& operator=(const OffsetPtr& other) noexcept {
+    set(other.get());
+    return *this;
+  }
+  OffsetPtr& operator=(T* ptr) noexcept {
+    set(ptr);
+    return *this;
+  }
+
+  T* get() const noexcept {
+    if (off == null_offset) return nullptr;
+    return reinterpret_cast<T*>(const_cast<char*>(reinterpret_cast<const char*>(this)) + off);
+  }
+  T* operator->() const noexcept { return get(); }
+  std::add_lvalue_reference_t<T> operator*() const noexcept { return *get(); }
+  explicit operator bool() const noexcept { return off != null_offset; }
+  bool operator==(const OffsetPtr& other) const noexcept { return get() == other.get(); }
+  bool operator!=(const OffsetPtr& other) const noexcept { return !(*this == other); }
+
+ private:
+  // the address one byte past the pointer is misaligned for T, so it encodes nullptr.
+  // 0 is no option, initToThis() makes the first link of a node point to itself
+  static constexpr std::ptrdiff_t null_offset = 1;
+
+  void set(T* ptr) noexcept {
+    // checked here, T may still be incomplete where the OffsetPtr member is declared
+    static_assert(alignof(T) > 1, "the null encoding needs targets aligned to more than one byte");
+    off = ptr ? reinterpret_cast<char*>(ptr) - reinterpret_cast<char*>(this) : null_offset;
+  }
+
+  std::ptrdiff_t off = null_offset;
+};
+
+namespace _priv {
+
+/// BaseNode with offset links, see BaseNode in List.hpp
+struct OffsetBaseNode {
+  OffsetPtr<OffsetBaseNode> prev;
+  OffsetPtr<OffsetBaseNode> next;
+
+  /// add <this OffsetBaseNode> before <node> in the chain of nodes
+  void hook(OffsetBaseNode* node) noexcept {
+    next = node;
+    prev = node->prev;
+    node->prev->next = this;
+    node->prev = this;
+  }
+
+  /// remove a link from the chain of nodes
+  void unhook() noexcept {
+    prev->next = next;
+    next->prev = prev;
+    prev = nullptr;
+    next = nullptr;
+  }
+
+  void initToThis() noexcept { prev = next = this; }
+};
+
+template <typename T>
+struct OffsetNode : OffsetBaseNode {
+  T value;
+};
+
+}  // namespace _priv
+
+/**
+ * @brief Named POSIX shared memory segment with a small allocator inside.
+ *
+ * The segment starts with a header holding a process-shared robust mutex and condition
+ * variable, size class free lists and one root object offset. Allocation is a bump
+ * pointer plus free lists, all offsets, so every process may map the segment at a
+ * different address. The allocator must be used with the segment lock held.
+ */
+class ShmSegment {
+ public:
+  static constexpr std::size_t granularity = 16;
+  static constexpr std::size_t max_block = 4096;
+
+  /**
+   * @brief Create a new segment, fails if the name exists.
+   * @param init Called with the new segment before it is published to open(),
+   * to allocate and set the root object. The name is removed again if it throws.
+   */
+  template <class Init>
+  static ShmSegment create(const char* name, std::size_t bytes, Init init);
+  static ShmSegment create(const char* name, std::size_t bytes) {
+    return create(name, bytes, [](ShmSegment&) {});
+  }
+  /**
+   * @brief Map an existing segment created by another process.
+   * @throw std::system_error EAGAIN while the creator is still initialising it, the
+   * caller may retry.
+   */
+  static ShmSegment open(const char* name);
+  /// remove the name, mappings stay valid until they are unmapped
+  static void remove(const char* name) noexcept { ::shm_unlink(name); }
+
+  ShmSegment(ShmSegment&& other) noexcept
+      : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+  ShmSegment(const ShmSegment&) = delete;
+  ShmSegment& operator=(const ShmSegment&) = delete;
+  ShmSegment& operator=(ShmSegment&&) = delete;
+  ~ShmSegment();
+
+  /// RAII holder of the segment mutex, recovers it when its owner died
+  class Lock {
+   public:
+    explicit Lock(ShmSegment& s);
+    /// does not throw, check the result with operator bool
+    Lock(ShmSegment& s, std::nothrow_t) noexcept;
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+    ~Lock() {
+      if (locked) ::pthread_mutex_unlock(&seg.header()->mtx);
+    }
+
+    explicit operator bool() const noexcept { return locked; }
+
+    /// wait on the segment condition variable
+    void wait();
+
+   private:
+    /// lock the mutex, 0 or the pthread error
+    int acquire() noexcept;
+
+    ShmSegment& seg;
+    bool locked = false;
+  };
+
+  /// @throw std::bad_alloc when the segment is full or size > max_block
+  void* allocate(std::size_t size);
+  void deallocate(void* ptr, std::size_t size) noexcept;
+
+  void* root() const noexcept { return header()->root.get(); }
+  /// @param ptr Block returned by allocate()
+  void set_root(void* ptr) noexcept { header()->root = static_cast<Block*>(ptr); }
+
+  void notify_all() noexcept { ::pthread_cond_broadcast(&header()->cond); }
+
+ private:
+  struct FreeSlot {
+    OffsetPtr<FreeSlot> next;
+  };
+
+  /// what allocate() hands out, typed for the root pointer
+  struct alignas(granularity) Block {};
+
+  static constexpr std::uint64_t magic_value = 0x4c49535453484d31ull;  // "LISTSHM1"
+  static constexpr std::size_t classes = max_block / granularity;
+
+  struct Header {
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment) std::uint64_t magic;  // published last
+    std::size_t size;
+    std::size_t bump;  // offset of the first never used byte
+    OffsetPtr<FreeSlot> free_lists[classes];
+    OffsetPtr<Block> root;
+    pthread_mutex_t mtx;
+    pthread_cond_t cond;
+  };
+
+  ShmSegment(void* b, std::size_t len) noexcept : base(b), length(len) {}
+
+  /// set up the header of a freshly mapped segment, without the magic
+  void initHeader(std::size_t bytes) noexcept;
+  Header* header() const noexcept { return static_cast<Header*>(base); }
+
+  static void* map(int fd, std::size_t bytes);
+
+  void* base;
+  std::size_t length;
+};
+
+/**
+ * @brief Doubly linked list of T inside a ShmSegment, used as a queue between processes.
+ *
+ * Nodes are _priv::OffsetNode<T> allocated in the segment, so a value constructed by
+ * emplace_back in one process is read in place by consume_front in another without
+ * being serialised or copied. All operations take the segment lock.
+ *
+ * @tparam T Value type, must be trivially copyable (no pointers into private memory).
+ */
+template <class T>
+class ShmList {
+  static_assert(std::is_trivially_copyable_v<T>, "ShmList values are shared between address spaces");
+
+  using BaseNode = _priv::OffsetBaseNode;
+  using Node = _priv::OffsetNode<T>;
+  static_assert(alignof(Node) <= ShmSegment::granularity, "the segment allocator aligns to granularity only");
+
+  struct Shared {
+    BaseNode m_root;
+    std::size_t sz;
+    bool closed;
+  };
+
+  explicit ShmList(ShmSegment&& s) noexcept : seg(std::move(s)), shared(static_cast<Shared*>(seg.root())) {}
+
+  ShmSegment seg;
+  Shared* shared;
+
+ public:
+  /// create the segment and an empty list in it
+  static ShmList create(const char* name, std::size_t bytes);
+  /**
+   * @brief Attach to a list created by another process.
+   * @throw std::system_error EAGAIN while the creator is still setting it up, retry.
+   */
+  static ShmList open(const char* name);
+
+  template <class... Args>
+  void emplace_back(Args&&... args);
+  void push_back(const T& value) { emplace_back(value); }
+
+  /**
+   * @brief Unlink the front node and call f(const T&) on the value in shared memory,
+   * without holding the lock, then free the node.
+   * @return bool false if the list was empty.
+   */
+  template <class F>
+  bool try_consume_front(F&& f);
+
+  /// like try_consume_front but waits for a value, false once closed and drained
+  template <class F>
+  bool consume_front(F&& f);
+
+  std::optional<T> try_pop_front();
+
+  /// wake waiting consumers, they drain what is left and then get false
+  void close();
+
+  std::size_t size();
+  bool empty() { return size() == 0; }
+
+ private:
+  /// unlink the front node under the lock, nullptr if empty
+  Node* unlinkFront() noexcept;
+  void freeNode(Node* ptr) noexcept;
+};
+
+inline void* ShmSegment::map(int fd, std::size_t bytes) {
+  void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int err = errno;
+  ::close(fd);
+  if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), "ShmSegment: mmap");
+  return p;
+}
+
+inline void ShmSegment::initHeader(std::size_t bytes) noexcept {
+  Header* h = ::new (base) Header;
+  h->size = bytes;
+  h->bump = (sizeof(Header) + granularity - 1) / granularity * granularity;
+
+  pthread_mutexattr_t mattr;
+  ::pthread_mutexattr_init(&mattr);
+  ::pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED);
+  ::pthread_mutexattr_setrobust(&mattr, PTHREAD_MUTEX_ROBUST);
+  ::pthread_mutex_init(&h->mtx, &mattr);
+  ::pthread_mutexattr_destroy(&mattr);
+
+  pthread_condattr_t cattr;
+  ::pthread_condattr_init(&cattr);
+  ::pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED);
+  ::pthread_cond_init(&h->cond, &cattr);
+  ::pthread_condattr_destroy(&cattr);
+}
+
+template <class Init>
+ShmSegment ShmSegment::create(const char* name, std::size_t bytes, Init init) {
+  if (bytes < sizeof(Header) + max_block) bytes = sizeof(Header) + max_block;
+  const int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) throw std::system_error(errno, std::generic_category(), "ShmSegment: shm_open");
+  if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    const int err = errno;
+    ::close(fd);
+    ::shm_unlink(name);
+    throw std::system_error(err, std::generic_category(), "ShmSegment: ftruncate");
+  }
+  try {
+    ShmSegment seg(map(fd, bytes), bytes);
+    seg.initHeader(bytes);
+    init(seg);
+    // published last, open() refuses the segment until it sees the magic
+    std::atomic_ref<std::uint64_t>(seg.header()->magic).store(magic_value, std::memory_order_release);
+    return seg;
+  } catch (...) {
+    ::shm_unlink(name);
+    throw;
+  }
+}
+
+inline ShmSegment ShmSegment::open(const char* name) {
+  const int fd = ::shm_open(name, O_RDWR, 0600);
+  if (fd < 0) throw std::system_error(errno, std::generic_category(), "ShmSegment: shm_open");
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    const int err = errno;
+    ::close(fd);
+    throw std::system_error(err, std::generic_category(), "ShmSegment: fstat");
+  }
+  if (static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);  // not truncated to its size yet
+    throw std::system_error(EAGAIN, std::generic_category(), "ShmSegment: not initialised");
+  }
+  ShmSegment seg(map(fd, static_cast<std::size_t>(st.st_size)), static_cast<std::size_t>(st.st_size));
+  if (std::atomic_ref<std::uint64_t>(seg.header()->magic).load(std::memory_order_acquire) != magic_value) {
+    throw std::system_error(EAGAIN, std::generic_category(), "ShmSegment: not initialised");
+  }
+  return seg;
+}
+
+inline ShmSegment::~ShmSegment() {
+  if (base) ::munmap(base, length);
+}
+
+inline int ShmSegment::Lock::acquire() noexcept {
+  int rc = ::pthread_mutex_lock(&seg.header()->mtx);
+  if (rc == EOWNERDEAD) {
+    // the list is only changed by short pointer updates, take it over as it is
+    rc = ::pthread_mutex_consistent(&seg.header()->mtx);
+  }
+  locked = rc == 0;
+  return rc;
+}
+
+inline ShmSegment::Lock::Lock(ShmSegment& s) : seg(s) {
+  const int rc = acquire();
+  if (rc != 0) throw std::system_error(rc, std::generic_category(), "ShmSegment: lock");
+}
+
+inline ShmSegment::Lock::Lock(ShmSegment& s, std::nothrow_t) noexcept : seg(s) {
+  acquire();
+}
+
+inline void ShmSegment::Lock::wait() {
+  const int rc = ::pthread_cond_wait(&seg.header()->cond, &seg.header()->mtx);
+  if (rc == EOWNERDEAD) ::pthread_mutex_consistent(&seg.header()->mtx);
+}
+
+inline void* ShmSegment::allocate(std::size_t size) {
+  if (size == 0 || size > max_block) throw std::bad_alloc();
+  Header* h = header();
+  const std::size_t cls = (size + granularity - 1) / granularity - 1;
+  if (FreeSlot* slot = h->free_lists[cls].get()) {
+    h->free_lists[cls] = slot->next;
+    return slot;
+  }
+  const std::size_t block = (cls + 1) * granularity;
+  if (h->size - h->bump < block) throw std::bad_alloc();
+  void* ret = static_cast<char*>(base) + h->bump;
+  h->bump += block;
+  return ret;
+}
+
+inline void ShmSegment::deallocate(void* ptr, std::size_t size) noexcept {
+  Header* h = header();
+  const std::size_t cls = (size + granularity - 1) / granularity - 1;
+  FreeSlot* slot = ::new (ptr) FreeSlot;
+  slot->next = h->free_lists[cls];
+  h->free_lists[cls] = slot;
+}
+
+template <class T>
+ShmList<T> ShmList<T>::create(const char* name, std::size_t bytes) {
+  return ShmList(ShmSegment::create(name, bytes, [](ShmSegment& seg) {
+    Shared* s = ::new (seg.allocate(sizeof(Shared))) Shared;
+    s->m_root.initToThis();
+    s->sz = 0;
+    s->closed = false;
+    seg.set_root(s);
+  }));
+}
+
+template <class T>
+ShmList<T> ShmList<T>::open(const char* name) {
+  ShmSegment seg = ShmSegment::open(name);
+  if (!seg.root()) throw std::system_error(EINVAL, std::generic_category(), "ShmList: segment has no list");
+  return ShmList(std::move(seg));
+}
+
+template <class T>
+template <class... Args>
+void ShmList<T>::emplace_back(Args&&... args) {
+  {
+    ShmSegment::Lock lock(seg);
+    Node* const newnode = static_cast<Node*>(seg.allocate(sizeof(Node)));
+    ::new (static_cast<void*>(newnode)) BaseNode;
+    try {
+      ::new (static_cast<void*>(&newnode->value)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      seg.deallocate(newnode, sizeof(Node));
+      throw;
+    }
+    newnode->hook(&shared->m_root);
+    ++shared->sz;
+  }
+  seg.notify_all();
+}
+
+template <class T>
+typename ShmList<T>::Node* ShmList<T>::unlinkFront() noexcept {
+  if (shared->sz == 0) return nullptr;
+  Node* node = static_cast<Node*>(shared->m_root.next.get());
+  node->unhook();
+  --shared->sz;
+  return node;
+}
+
+template <class T>
+void ShmList<T>::freeNode(Node* ptr) noexcept {
+  ShmSegment::Lock lock(seg, std::nothrow);
+  // with the mutex unrecoverable the segment is unusable anyway, the block leaks
+  if (lock) seg.deallocate(ptr, sizeof(Node));
+}
+
+template <class T>
+template <class F>
+bool ShmList<T>::try_consume_front(F&& f) {
+  Node* node;
+  {
+    ShmSegment::Lock lock(seg);
+    node = unlinkFront();
+  }
+  if (!node) return false;
+  try {
+    f(static_cast<const T&>(node->value));
+  } catch (...) {
+    freeNode(node);
+    throw;
+  }
+  freeNode(node);
+  return true;
+}
+
+template <class T>
+template <class F>
+bool ShmList<T>::consume_front(F&& f) {
+  Node* node;
+  {
+    ShmSegment::Lock lock(seg);
+    while (shared->sz == 0 && !shared->closed) lock.wait();
+    node = unlinkFront();
+  }
+  if (!node) return false;
+  try {
+    f(static_cast<const T&>(node->value));
+  } catch (...) {
+    freeNode(node);
+    throw;
+  }
+  freeNode(node);
+  return true;
+}
+
+template <class T>
+std::optional<T> ShmList<T>::try_pop_front() {
+  std::optional<T> ret;
+  try_consume_front([&ret](const T& value) { ret = value; });
+  return ret;
+}
+
+template <class T>
+void ShmList<T>::close() {
+  {
+    ShmSegment::Lock lock(seg);
+    shared->closed = true;
+  }
+  seg.notify_all();
+}
+
+template <class T>
+std::size_t ShmList<T>::size() {
+  ShmSegment::Lock lock(seg);
+  return shared->sz;
+}
+
+#endif  // _SHM_LIST_HPP_
@@ -0,0 +1,285 @@
+/**
+ * @file SortedList.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief List kept in order, with finger search for hinted insertion
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _SORTED_LIST_HPP_
+#define _SORTED_LIST_HPP_
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "List.hpp"
+
+/**
+ * @brief Ordered List. Equal elements keep insertion order.
+ *
+ * Searches start from whichever of front, back and the finger (the last position
+ * inserted or erased at) is nearest, then walk toward the target. Appending in order
+ * is O(1), near-monotonic insertion is amortised O(1), lookups close to the previous
+ * one are O(distance). For arithmetic T "nearest" is measured by key difference,
+ * otherwise the finger is preferred over the ends. Only modifying calls move the
+ * finger, so const lookups may run concurrently like on the standard containers.
+ *
+ * Only const iterators are handed out, changing a value in place could break the order.
+ *
+ * @tparam T Value type.
+ * @tparam Compare Strict weak ordering.
+ * @tparam Allocator Allocator passed on to the underlying List.
+ */
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+class SortedList {
+ public:
+  using list_type = List<T, Allocator>;
+  using value_type = T;
+  using value_compare = Compare;
+  using size_type = std::size_t;
+  using const_reference = const T&;
+  using const_iterator = typename list_type::const_iterator;
+  using iterator = const_iterator;
+  using const_reverse_iterator = typename list_type::const_reverse_iterator;
+
+ private:
+  list_type list;
+  Compare comp;
+  const_iterator finger;  // end() when unset
+
+  /**
+   * @brief First position where before(*it) is false, before must be true
+   * for a prefix of the list and false for the rest.
+   */
+  template <class Before>
+  const_iterator search(const T& value, Before before, const_iterator hint) const;
+
+  /// true if the key distance |value - a| is larger than |value - b|
+  bool fartherThan(const T& value, const T& a, const T& b) const;
+
+ public:
+  explicit SortedList(const Compare& compare = Compare(), const Allocator& allocator = Allocator());
+  // the finger points into the own list, copies and moves start without one
+  SortedList(const SortedList& other);
+  SortedList(SortedList&& other) noexcept;
+  SortedList& operator=(const SortedList& other);
+  SortedList& operator=(SortedList&& other);
+
+  const_iterator begin() const noexcept { return list.cbegin(); }
+  const_iterator cbegin() const noexcept { return list.cbegin(); }
+  const_iterator end() const noexcept { return list.cend(); }
+  const_iterator cend() const noexcept { return list.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return list.rcbegin(); }
+  const_reverse_iterator rend() const noexcept { return list.rcend(); }
+
+  /**
+   * @brief Insert value after all elements that are not greater than it.
+   * @param hint Optional extra starting point for the search, e.g. the position of a
+   * related element. end() means no hint.
+   * @return const_iterator Iterator to the inserted element.
+   */
+  const_iterator insert(const T& value);
+  const_iterator insert(T&& value);
+  const_iterator insert(const_iterator hint, const T& value);
+  const_iterator insert(const_iterator hint, T&& value);
+
+  template <class... Args>
+  const_iterator emplace(Args&&... args);
+
+  /// first element not less than value
+  const_iterator lower_bound(const T& value) const;
+  /// first element greater than value
+  const_iterator upper_bound(const T& value) const;
+  /// an element equal to value or end()
+  const_iterator find(const T& value) const;
+
+  const_iterator erase(const_iterator pos);
+  const_iterator erase(const_iterator first, const_iterator last);
+  void pop_front();
+  void pop_back();
+
+  const_reference front() const noexcept { return list.front(); }
+  const_reference back() const noexcept { return list.back(); }
+
+  size_t size() const noexcept { return list.size(); }
+  bool empty() const noexcept { return list.empty(); }
+  void clear() noexcept;
+};
+
+template <class T, class Compare, class Allocator>
+SortedList<T, Compare, Allocator>::SortedList(const Compare& compare, const Allocator& allocator)
+    : list(allocator), comp(compare), finger(list.cend()) {}
+
+template <class T, class Compare, class Allocator>
+SortedList<T, Compare, Allocator>::SortedList(const SortedList& other)
+    : list(other.list), comp(other.comp), finger(list.cend()) {}
+
+template <class T, class Compare, class Allocator>
+SortedList<T, Compare, Allocator>::SortedList(SortedList&& other) noexcept
+    : list(std::move(other.list)), comp(other.comp), finger(list.cend()) {
+  other.finger = other.list.cend();
+}
+
+template <class T, class Compare, class Allocator>
+SortedList<T, Compare, Allocator>& SortedList<T, Compare, Allocator>::operator=(const SortedList& other) {
+  list = other.list;
+  comp = other.comp;
+  finger = list.cend();
+  return *this;
+}
+
+template <class T, class Compare, class Allocator>
+SortedList<T, Compare, Allocator>& SortedList<T, Compare, Allocator>::operator=(SortedList&& other) {
+  list = std::move(other.list);
+  comp = other.comp;
+  finger = list.cend();
+  other.finger = other.list.cend();
+  return *this;
+}
+
+template <class T, class Compare, class Allocator>
+bool SortedList<T, Compare, Allocator>::fartherThan(const T& value, const T& a, const T& b) const {
+  if constexpr (std::is_floating_point_v<T>) {
+    using D = std::conditional_t<(sizeof(T) > sizeof(double)), T, double>;
+    const D da = value < a ? D(a) - D(value) : D(value) - D(a);
+    const D db = value < b ? D(b) - D(value) : D(value) - D(b);
+    return da > db;
+  } else if constexpr (std::is_integral_v<T>) {
+    // the difference of far apart signed keys only fits the unsigned type
+    using U = std::make_unsigned_t<std::conditional_t<std::is_same_v<T, bool>, int, T>>;
+    const U da = value < a ? U(a) - U(value) : U(value) - U(a);
+    const U db = value < b ? U(b) - U(value) : U(value) - U(b);
+    return da > db;
+  } else {
+    return false;
+  }
+}
+
+template <class T, class Compare, class Allocator>
+template <class Before>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::search(
+    const T& value, Before before, const_iterator hint) const {
+  const_iterator ret = list.cend();
+  if (list.empty() || before(list.back())) return ret;  // common case for in-order appends
+  if (!before(list.front())) return list.cbegin();
+  // now front is before the result and back is not, both walks below stop inside the list
+  const_iterator from = finger;
+  if (hint != list.cend() && (from == list.cend() || fartherThan(value, *from, *hint))) from = hint;
+  if (from == list.cend()) from = fartherThan(value, list.front(), list.back()) ? --list.cend() : list.cbegin();
+
+  if (before(*from)) {
+    if (fartherThan(value, *from, list.back())) {
+      ret = --list.cend();
+      for (const_iterator p = ret; !before(*--p); ret = p) {
+      }
+    } else {
+      for (ret = from; before(*ret); ++ret) {
+      }
+    }
+  } else {
+    if (fartherThan(value, *from, list.front())) {
+      for (ret = list.cbegin(); before(*ret); ++ret) {
+      }
+    } else {
+      ret = from;
+      for (const_iterator p = ret; !before(*--p); ret = p) {
+      }
+    }
+  }
+  return ret;
+}
+
+template <class T, class Compare, class Allocator>
+inline typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::insert(
+    const T& value) {
+  return insert(list.cend(), value);
+}
+
+template <class T, class Compare, class Allocator>
+inline typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::insert(
+    T&& value) {
+  return insert(list.cend(), std::move(value));
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::insert(
+    const_iterator hint, const T& value) {
+  const_iterator pos = search(value, [&](const T& e) { return !comp(value, e); }, hint);
+  finger = list.insert(pos, value);
+  return finger;
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::insert(
+    const_iterator hint, T&& value) {
+  const_iterator pos = search(value, [&](const T& e) { return !comp(value, e); }, hint);
+  finger = list.insert(pos, std::move(value));
+  return finger;
+}
+
+template <class T, class Compare, class Allocator>
+template <class... Args>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::emplace(
+    Args&&... args) {
+  T value(std::forward<Args>(args)...);
+  return insert(list.cend(), std::move(value));
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::lower_bound(
+    const T& value) const {
+  return search(value, [&](const T& e) { return comp(e, value); }, list.cend());
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::upper_bound(
+    const T& value) const {
+  return search(value, [&](const T& e) { return !comp(value, e); }, list.cend());
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::find(
+    const T& value) const {
+  const_iterator it = lower_bound(value);
+  if (it != list.cend() && !comp(value, *it)) return it;
+  return list.cend();
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::erase(
+    const_iterator pos) {
+  const bool at_finger = finger == pos;
+  const_iterator ret = list.erase(pos);
+  if (at_finger) finger = ret;
+  return ret;
+}
+
+template <class T, class Compare, class Allocator>
+typename SortedList<T, Compare, Allocator>::const_iterator SortedList<T, Compare, Allocator>::erase(
+    const_iterator first, const_iterator last) {
+  while (first != last) first = erase(first);
+  return last;
+}
+
+template <class T, class Compare, class Allocator>
+inline void SortedList<T, Compare, Allocator>::pop_front() {
+  erase(list.cbegin());
+}
+
+template <class T, class Compare, class Allocator>
+inline void SortedList<T, Compare, Allocator>::pop_back() {
+  erase(--list.cend());
+}
+
+template <class T, class Compare, class Allocator>
+inline void SortedList<T, Compare, Allocator>::clear() noexcept {
+  list.clear();
+  finger = list.cend();
+}
+
+#endif  // _SORTED_LIST_HPP_
@@ -0,0 +1,227 @@
+/**
+ * @file TimingWheel.hpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Hierarchical timing wheel with List buckets
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef _TIMING_WHEEL_HPP_
+#define _TIMING_WHEEL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "List.hpp"
+
+/**
+ * @brief Timer queue with O(1) schedule and cancel.
+ *
+ * Time is counted in ticks. There are levels of 256 slots each, level L covering
+ * 256^(L+1) ticks; a timer sits on the lowest level on which its expiry and the
+ * current time share all higher digits, timers further away than the top level wait
+ * in an overflow bucket. When the low digits of the time wrap, the matching slot of
+ * the level above is cascaded down. Every bucket is a List and timers move between
+ * buckets with List::splice, so a TimerHandle (an iterator to the timer) stays valid
+ * until the timer fires or is cancelled.
+ *
+ * Not thread-safe.
+ *
+ * @tparam Callback Callable with signature void(), invoked when the timer fires.
+ */
+template <class Callback = std::function<void()>>
+class TimingWheel {
+ public:
+  using tick_type = std::uint64_t;
+
+  struct Timer;
+  using bucket_type = List<Timer>;
+
+  struct Timer {
+    tick_type expiry;
+    Callback callback;
+    bucket_type* bucket;  // bucket the node currently lives in, needed to erase it
+  };
+
+  using TimerHandle = typename bucket_type::iterator;
+
+  static constexpr unsigned slot_bits = 8;
+  static constexpr std::size_t slots = std::size_t(1) << slot_bits;
+  static constexpr unsigned levels = 4;
+
+  /// @param now Current time in ticks.
+  explicit TimingWheel(tick_type now = 0);
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /**
+   * @brief Arm a timer for an absolute time. Timers already due fire on the next advance(),
+   * even when it does not move the time.
+   * @return TimerHandle Handle for cancel(), valid until the timer fires or is cancelled.
+   */
+  TimerHandle schedule(tick_type expiry, Callback callback);
+
+  /// arm a timer delay ticks from now
+  TimerHandle schedule_after(tick_type delay, Callback callback);
+
+  /// disarm a pending timer, the handle is invalid afterwards
+  void cancel(TimerHandle handle) noexcept;
+
+  /**
+   * @brief Move the time forward to now and fire every timer with expiry <= now,
+   * in expiry order. Callbacks run after the time was updated and may schedule and
+   * cancel timers, including other timers due in the same batch.
+   * @return size_t Number of fired timers.
+   */
+  std::size_t advance(tick_type now);
+
+  tick_type now() const noexcept { return current; }
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+
+ private:
+  static constexpr tick_type slotOf(tick_type t, unsigned level) noexcept {
+    return (t >> (slot_bits * level)) & (slots - 1);
+  }
+
+  /// bucket for expiry relative to the next tick to be processed
+  bucket_type& bucketFor(tick_type expiry) noexcept;
+
+  /// move the timer at it from its bucket to the right one for its expiry
+  void place(typename bucket_type::iterator it) noexcept;
+
+  /// redistribute every timer of from to lower levels
+  void cascade(bucket_type& from) noexcept;
+
+  /// first tick >= t that fires or cascades a non-empty bucket, ~0 if there is none
+  tick_type nextEvent(tick_type t) const noexcept;
+
+  bucket_type wheel[levels][slots];
+  bucket_type overflow;
+  bucket_type expired;  // timers of the running advance() batch
+  tick_type current;    // every tick up to and including current is processed
+  std::size_t count = 0;
+};
+
+template <class Callback>
+TimingWheel<Callback>::TimingWheel(tick_type now) : current(now) {}
+
+template <class Callback>
+typename TimingWheel<Callback>::bucket_type& TimingWheel<Callback>::bucketFor(tick_type expiry) noexcept {
+  const tick_type base = current + 1;
+  if (expiry < base) expiry = base;  // not reached from schedule(), due timers go to expired there
+  for (unsigned level = 0; level != levels; ++level) {
+    const unsigned shift = slot_bits * (level + 1);
+    if ((expiry >> shift) == (base >> shift)) return wheel[level][slotOf(expiry, level)];
+  }
+  return overflow;
+}
+
+template <class Callback>
+void TimingWheel<Callback>::place(typename bucket_type::iterator it) noexcept {
+  bucket_type& to = bucketFor(it->expiry);
+  if (&to == it->bucket) return;
+  to.splice(to.end(), *it->bucket, it);
+  it->bucket = &to;
+}
+
+template <class Callback>
+void TimingWheel<Callback>::cascade(bucket_type& from) noexcept {
+  for (auto it = from.begin(); it != from.end();) {
+    auto next = std::next(it);
+    place(it);  // far timers of the overflow bucket stay where they are
+    it = next;
+  }
+}
+
+template <class Callback>
+typename TimingWheel<Callback>::tick_type TimingWheel<Callback>::nextEvent(tick_type t) const noexcept {
+  tick_type next = ~tick_type(0);
+  for (unsigned level = 0; level != levels; ++level) {
+    const unsigned shift = slot_bits * level;
+    const tick_type low = (tick_type(1) << shift) - 1;
+    // slot k of this level is handled on the tick with digit k here and zeros below
+    for (tick_type k = slotOf(t, level) + ((t & low) ? 1 : 0); k < slots; ++k) {
+      if (!wheel[level][k].empty()) {
+        const unsigned up = shift + slot_bits;
+        next = std::min(next, ((t >> up) << up) | (k << shift));
+        break;
+      }
+    }
+  }
+  if (!overflow.empty()) {
+    const unsigned top = slot_bits * levels;
+    const tick_type wrap = (t & ((tick_type(1) << top) - 1)) ? ((t >> top) + 1) << top : t;
+    next = std::min(next, wrap);
+  }
+  return next;
+}
+
+template <class Callback>
+typename TimingWheel<Callback>::TimerHandle TimingWheel<Callback>::schedule(tick_type expiry, Callback callback) {
+  if (expiry <= current) {
+    // already due: straight into the batch of the next advance(), kept in expiry order
+    auto pos = expired.end();
+    for (auto prev = pos; pos != expired.begin() && (--prev)->expiry > expiry; pos = prev) {
+    }
+    ++count;
+    return expired.insert(pos, Timer{expiry, std::move(callback), &expired});
+  }
+  bucket_type& to = bucketFor(expiry);
+  to.push_back(Timer{expiry, std::move(callback), &to});
+  ++count;
+  return --to.end();
+}
+
+template <class Callback>
+inline typename TimingWheel<Callback>::TimerHandle TimingWheel<Callback>::schedule_after(tick_type delay,
+                                                                                       Callback callback) {
+  return schedule(current + delay, std::move(callback));
+}
+
+template <class Callback>
+inline void TimingWheel<Callback>::cancel(TimerHandle handle) noexcept {
+  handle->bucket->erase(handle);
+  --count;
+}
+
+template <class Callback>
+std::size_t TimingWheel<Callback>::advance(tick_type now) {
+  while (current < now) {
+    // skip the ticks on which nothing fires or cascades
+    const tick_type t = count == expired.size() ? ~tick_type(0) : nextEvent(current + 1);
+    if (t > now) {
+      current = now;
+      break;
+    }
+    current = t - 1;  // t is still the next tick while cascading, see bucketFor
+    // cascade from the top so timers can fall through several levels in one tick
+    if ((t & ((tick_type(1) << (slot_bits * levels)) - 1)) == 0) cascade(overflow);
+    for (unsigned level = levels - 1; level != 0; --level) {
+      if ((t & ((tick_type(1) << (slot_bits * level)) - 1)) == 0) cascade(wheel[level][slotOf(t, level)]);
+    }
+    bucket_type& due = wheel[0][slotOf(t, 0)];
+    for (auto it = due.begin(); it != due.end(); ++it) it->bucket = &expired;
+    expired.splice(expired.end(), due);
+    current = t;
+  }
+
+  std::size_t fired = 0;
+  while (!expired.empty()) {
+    Callback callback = std::move(expired.front().callback);
+    expired.pop_front();
+    --count;
+    ++fired;
+    callback();
+  }
+  return fired;
+}
+
+#endif  // _TIMING_WHEEL_HPP_
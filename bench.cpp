@@ -0,0 +1,435 @@
+/**
+ * @file bench.cpp
+ * @author Enver Kulametov (zizu.meridian@gmail.com)
+ * @brief Benchmarks for List.hpp and the containers built on it
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Usage: bench [name] [size], name is one of the sections below or "all".
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "HugePageArena.hpp"
+#include "List.hpp"
+#include "NodeCache.hpp"
+#include "RcuList.hpp"
+#include "TimingWheel.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// dTLB load miss counter for the calling thread, reads -1 when perf events are unavailable
+class TlbCounter {
+ public:
+  TlbCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+  TlbCounter(const TlbCounter&) = delete;
+  TlbCounter& operator=(const TlbCounter&) = delete;
+  ~TlbCounter() {
+#ifdef __linux__
+    if (fd >= 0) ::close(fd);
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd < 0) return;
+    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  long long stop() {
+#ifdef __linux__
+    if (fd < 0) return -1;
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long value = 0;
+    if (::read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+    return value;
+#else
+    return -1;
+#endif
+  }
+
+ private:
+  int fd = -1;
+};
+
+std::string counted(long long value) {
+  return value < 0 ? std::string("n/a") : std::to_string(value);
+}
+
+template <class L>
+void traverseAndErase(const char* name, L& l, std::size_t n) {
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i != n; ++i) l.push_back(rng());
+
+  // interleave the chain so traversal jumps around memory like a long-lived list does
+  std::vector<typename L::iterator> its;
+  its.reserve(n);
+  for (auto it = l.begin(); it != l.end(); ++it) its.push_back(it);
+  std::shuffle(its.begin(), its.end(), rng);
+  for (std::size_t i = 0; i != n / 2; ++i) {
+    l.erase(its[i]);
+    l.push_back(rng());
+  }
+
+  TlbCounter tlb;
+  tlb.start();
+  auto start = Clock::now();
+  std::uint64_t sum = 0;
+  for (int rep = 0; rep != 3; ++rep) {
+    for (auto it = l.cbegin(); it != l.cend(); ++it) sum += *it;
+  }
+  const double traverse_ms = msSince(start) / 3;
+  const long long traverse_tlb = tlb.stop();
+
+  its.clear();
+  for (auto it = l.begin(); it != l.end(); ++it) its.push_back(it);
+  std::shuffle(its.begin(), its.end(), rng);
+  const std::size_t erases = n / 4;
+  tlb.start();
+  start = Clock::now();
+  for (std::size_t i = 0; i != erases; ++i) l.erase(its[i]);
+  const double erase_ms = msSince(start);
+  const long long erase_tlb = tlb.stop();
+
+  std::cout << name << ": traverse " << traverse_ms << " ms (dTLB misses "
+            << counted(traverse_tlb < 0 ? -1 : traverse_tlb / 3) << "), " << erases << " random erases " << erase_ms << " ms (dTLB misses " << counted(erase_tlb) << ")"
+            << "  [checksum " << (sum & 0xff) << "]\n";
+}
+
+void benchHugePages(std::size_t n) {
+  std::cout << "----huge pages, " << n << " nodes----\n";
+  {
+    List<std::uint64_t> l;
+    traverseAndErase("std::allocator     ", l, n);
+  }
+  const HugePageArena::Pages modes[] = {HugePageArena::Pages::Normal, HugePageArena::Pages::Transparent,
+                                        HugePageArena::Pages::Explicit};
+  const char* names[] = {"arena 4K pages     ", "arena THP          ", "arena MAP_HUGETLB  "};
+  for (int i = 0; i != 3; ++i) {
+    auto arena = std::make_shared<HugePageArena>(modes[i]);
+    List<std::uint64_t, HugePageAllocator<std::uint64_t>> l{HugePageAllocator<std::uint64_t>(arena)};
+    traverseAndErase(names[i], l, n);
+    if (modes[i] == HugePageArena::Pages::Explicit) {
+      std::cout << "  " << arena->hugetlb_chunks() << " of " << arena->chunks() << " chunks from MAP_HUGETLB\n";
+    }
+  }
+}
+
+struct CountedCopy {
+  static inline std::size_t copies = 0;
+  std::uint64_t v;
+  explicit CountedCopy(std::uint64_t v = 0) : v(v) {}
+  CountedCopy(const CountedCopy& o) : v(o.v) { ++copies; }
+  CountedCopy(CountedCopy&& o) noexcept = default;
+};
+
+void benchRelocate(std::size_t n) {
+  std::cout << "----vector<List> reallocation, " << n << " lists of 16----\n";
+  CountedCopy::copies = 0;
+  auto start = Clock::now();
+  std::vector<List<CountedCopy>> v;
+  for (std::size_t i = 0; i != n; ++i) {
+    v.emplace_back();
+    for (std::uint64_t j = 0; j != 16; ++j) v.back().emplace_back(j);
+  }
+  std::cout << "grow without reserve: " << msSince(start) << " ms, " << CountedCopy::copies << " element copies\n";
+
+  CountedCopy::copies = 0;
+  start = Clock::now();
+  std::vector<List<CountedCopy>> w;
+  w.reserve(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    w.emplace_back();
+    for (std::uint64_t j = 0; j != 16; ++j) w.back().emplace_back(j);
+  }
+  std::cout << "grow with reserve:    " << msSince(start) << " ms, " << CountedCopy::copies << " element copies\n";
+}
+
+volatile std::uint64_t sink;  // keeps traversals from being optimised away
+
+struct ReadStats {
+  double reads_per_ms;
+  double p99_us;
+};
+
+/// run readers traversals for a fixed time next to a writer, read(i) does one traversal
+template <class Read, class Write>
+ReadStats runReaders(int threads, Read read, Write write) {
+  std::atomic<bool> done = false;
+  std::vector<std::vector<float>> latencies(threads);
+  std::vector<std::thread> pool;
+  for (int t = 0; t != threads; ++t) {
+    pool.emplace_back([&, t] {
+      auto& lat = latencies[t];
+      auto state = read.prepare();
+      while (!done.load(std::memory_order_relaxed)) {
+        const auto start = Clock::now();
+        read(state);
+        lat.push_back(std::chrono::duration<float, std::micro>(Clock::now() - start).count());
+      }
+    });
+  }
+  const auto start = Clock::now();
+  int update = 0;
+  while (msSince(start) < 300) {
+    write(update++);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  done = true;
+  for (auto& th : pool) th.join();
+  const double elapsed = msSince(start);
+
+  std::vector<float> all;
+  for (auto& lat : latencies) all.insert(all.end(), lat.begin(), lat.end());
+  std::sort(all.begin(), all.end());
+  const double p99 = all.empty() ? 0 : all[all.size() * 99 / 100];
+  return ReadStats{all.size() / elapsed, p99};
+}
+
+void benchRcu(std::size_t n) {
+  std::cout << "----RcuList vs shared_mutex + List, " << n << " routes, writer every 100us----\n";
+  const int max_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    RcuList<std::uint64_t> rcu(threads + 1);
+    for (std::size_t i = 0; i != n; ++i) rcu.push_back(i);
+    struct RcuRead {
+      RcuList<std::uint64_t>* list;
+      RcuList<std::uint64_t>::Reader prepare() const { return list->reader(); }
+      void operator()(RcuList<std::uint64_t>::Reader& r) const {
+        std::uint64_t sum = 0;
+        r.for_each([&](std::uint64_t v) { sum += v; });
+        sink = sum;
+      }
+    };
+    const ReadStats a = runReaders(threads, RcuRead{&rcu}, [&](int u) {
+      const std::uint64_t key = static_cast<std::uint64_t>(u) % n;
+      rcu.replace_if([&](std::uint64_t v) { return v == key; }, key);
+    });
+
+    std::shared_mutex mtx;
+    List<std::uint64_t> locked;
+    for (std::size_t i = 0; i != n; ++i) locked.push_back(i);
+    struct LockedRead {
+      std::shared_mutex* mtx;
+      const List<std::uint64_t>* list;
+      int prepare() const { return 0; }
+      void operator()(int) const {
+        std::shared_lock lock(*mtx);
+        std::uint64_t sum = 0;
+        for (auto it = list->cbegin(); it != list->cend(); ++it) sum += *it;
+        sink = sum;
+      }
+    };
+    const ReadStats b = runReaders(threads, LockedRead{&mtx, &locked}, [&](int u) {
+      const std::uint64_t key = static_cast<std::uint64_t>(u) % n;
+      std::unique_lock lock(mtx);
+      for (auto it = locked.begin(); it != locked.end(); ++it) {
+        if (*it == key) {
+          locked.insert(it, key);
+          locked.erase(it);
+          break;
+        }
+      }
+    });
+
+    std::cout << threads << " readers: rcu " << a.reads_per_ms << " reads/ms p99 " << a.p99_us
+              << " us | shared_mutex " << b.reads_per_ms << " reads/ms p99 " << b.p99_us << " us\n";
+  }
+}
+
+struct CountFire {
+  std::size_t* fired;
+  void operator()() const { ++*fired; }
+};
+
+void benchTimingWheel(std::size_t n) {
+  std::cout << "----timing wheel, " << n << " active timers----\n";
+  std::size_t fired = 0;
+  TimingWheel<CountFire> wheel;
+  std::vector<TimingWheel<CountFire>::TimerHandle> handles;
+  handles.reserve(n);
+  std::mt19937_64 rng(11);
+  const std::uint64_t horizon = 600000;  // ten minutes of 1 ms ticks
+
+  auto start = Clock::now();
+  for (std::size_t i = 0; i != n; ++i) handles.push_back(wheel.schedule(1 + rng() % horizon, CountFire{&fired}));
+  std::cout << "schedule: " << msSince(start) * 1e6 / n << " ns/timer\n";
+
+  // idle timers are pushed back on every packet: cancel and arm again
+  start = Clock::now();
+  for (std::size_t i = 0; i != n; ++i) {
+    auto& h = handles[rng() % n];
+    const std::uint64_t expiry = h->expiry + 1000;
+    wheel.cancel(h);
+    h = wheel.schedule(expiry, CountFire{&fired});
+  }
+  std::cout << "rearm (cancel + schedule): " << msSince(start) * 1e6 / n << " ns/timer\n";
+
+  start = Clock::now();
+  std::size_t batches = 0;
+  for (std::uint64_t now = 1; !wheel.empty(); now += 10) {
+    wheel.advance(now);
+    ++batches;
+  }
+  std::cout << "advance in " << batches << " batches of 10 ticks: " << msSince(start) * 1e6 / fired
+            << " ns/fired timer, " << fired << " fired\n";
+}
+
+/// List handed between threads under a mutex, the receiver spins on the size
+template <class Allocator>
+struct Mailbox {
+  std::mutex mtx;
+  List<std::uint64_t, Allocator> items;
+  std::atomic<std::size_t> count = 0;
+
+  void send(List<std::uint64_t, Allocator>& batch) {
+    const std::size_t n = batch.size();
+    std::lock_guard lock(mtx);
+    items.splice(items.end(), batch);
+    count.fetch_add(n, std::memory_order_release);
+  }
+
+  void receive(List<std::uint64_t, Allocator>& out, std::size_t n) {
+    while (count.load(std::memory_order_acquire) < n) std::this_thread::yield();
+    std::lock_guard lock(mtx);
+    out.splice(out.end(), items);
+    count.fetch_sub(n, std::memory_order_relaxed);
+  }
+};
+
+/// round trip latencies in power of two ns buckets
+struct Histogram {
+  std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(40);
+  std::vector<std::uint64_t> samples;
+
+  void add(std::uint64_t ns) {
+    ++buckets[ns ? std::min<std::size_t>(63 - __builtin_clzll(ns), buckets.size() - 1) : 0];
+    samples.push_back(ns);
+  }
+
+  void print() {
+    std::sort(samples.begin(), samples.end());
+    auto pct = [&](double p) { return samples[static_cast<std::size_t>(p * (samples.size() - 1))]; };
+    std::cout << "  p50 " << pct(0.5) << " ns, p90 " << pct(0.9) << " ns, p99 " << pct(0.99) << " ns, p99.9 "
+              << pct(0.999) << " ns, max " << samples.back() << " ns\n";
+    for (std::size_t b = 0; b != buckets.size(); ++b) {
+      if (!buckets[b]) continue;
+      std::cout << "  [" << (std::uint64_t(1) << b) << ", " << (std::uint64_t(1) << (b + 1)) << ") ns: " << buckets[b]
+                << '\n';
+    }
+  }
+};
+
+/**
+ * Two threads bounce bursts of nodes: each side allocates a burst, sends it and
+ * destroys the burst it receives, so every node is freed on the other thread.
+ */
+template <class Allocator>
+void pingPong(const char* name, std::size_t rounds, std::size_t burst) {
+  Mailbox<Allocator> to_pong;
+  Mailbox<Allocator> to_ping;
+  Histogram hist;
+  hist.samples.reserve(rounds);
+
+  std::thread pong([&] {
+    List<std::uint64_t, Allocator> in;
+    List<std::uint64_t, Allocator> out;
+    for (std::size_t r = 0; r != rounds; ++r) {
+      to_pong.receive(in, burst);
+      std::uint64_t sum = 0;
+      while (!in.empty()) {
+        sum += in.front();
+        in.pop_front();
+      }
+      for (std::size_t i = 0; i != burst; ++i) out.push_back(sum + i);
+      to_ping.send(out);
+    }
+  });
+
+  List<std::uint64_t, Allocator> in;
+  List<std::uint64_t, Allocator> out;
+  const auto start = Clock::now();
+  for (std::size_t r = 0; r != rounds; ++r) {
+    const auto t0 = Clock::now();
+    for (std::size_t i = 0; i != burst; ++i) out.push_back(r + i);
+    to_pong.send(out);
+    to_ping.receive(in, burst);
+    std::uint64_t sum = 0;
+    while (!in.empty()) {
+      sum += in.front();
+      in.pop_front();
+    }
+    sink = sum;
+    hist.add(static_cast<std::uint64_t>(std::chrono::duration<double, std::nano>(Clock::now() - t0).count()));
+  }
+  const double elapsed = msSince(start);
+  pong.join();
+  std::cout << name << ": " << elapsed * 1e6 / (rounds * burst * 2) << " ns/node\n";
+  hist.print();
+}
+
+void benchPingPong(std::size_t rounds) {
+  for (std::size_t burst : {1, 64}) {
+    std::cout << "----ping-pong, " << rounds << " round trips of " << burst << " nodes each way----\n";
+    pingPong<std::allocator<std::uint64_t>>("std::allocator", rounds, burst);
+    pingPong<NodeCacheAllocator<std::uint64_t>>("NodeCacheAllocator", rounds, burst);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string which = argc > 1 ? argv[1] : "all";
+  const std::size_t size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+  if (which == "all" || which == "hugepages") benchHugePages(size ? size : 4000000);
+  if (which == "all" || which == "relocate") benchRelocate(size ? size : 1000000);
+  if (which == "all" || which == "rcu") benchRcu(size ? size : 256);
+  if (which == "all" || which == "timers") benchTimingWheel(size ? size : 1000000);
+  if (which == "all" || which == "pingpong") benchPingPong(size ? size : 100000);
+
+  return 0;
+}
@@ -10,12 +10,31 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <list>
+#include <mutex>
 #include <memory>
-
+#include <random>
+#include <sys/wait.h>
+#include <thread>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AdaptiveList.hpp"
+#include "AsyncChannel.hpp"
+#include "HugePageArena.hpp"
 #include "List.hpp"
+#include "NodeCache.hpp"
+#include "PersistentList.hpp"
+#include "RcuList.hpp"
+#include "ShmList.hpp"
+#include "SortedList.hpp"
+#include "TimingWheel.hpp"
 
 struct A {
   std::string str;
@@ -238,6 +257,637 @@ void testInsertIt() {
   l.clear();
 }
 
+Task producer(AsyncChannel<int>& ch, int from, int to) {
+  for (int i = from; i != to; ++i) {
+    co_await ch.push(i);
+  }
+}
+
+Task consumer(AsyncChannel<int>& ch, std::atomic<long>& sum, std::atomic<int>& count) {
+  for (;;) {
+    std::optional<int> v = co_await ch.pop();
+    if (!v) break;
+    sum += *v;
+    ++count;
+  }
+}
+
+Task batchConsumer(AsyncChannel<int>& ch, List<int>& out) {
+  for (;;) {
+    std::size_t n = co_await ch.pop_n(out, 3);
+    if (n == 0) break;
+  }
+}
+
+void testAsyncChannel() {
+  std::cout << "----Test AsyncChannel single thread----\n";
+  InlineExecutor ex;
+  AsyncChannel<int> ch(ex, 2);
+  List<int> out;
+  ex.spawn(batchConsumer(ch, out));
+  ex.spawn(producer(ch, 0, 10));
+  ex.run();
+  std::cout << "buffered " << ch.size() << " of capacity " << ch.capacity() << "\n";
+  ch.close();
+  ex.run();
+  int expect = 0;
+  for (auto it = out.cbegin(); it != out.cend(); ++it) assert(*it == expect++);
+  assert(out.size() == 10);
+  std::cout << "received " << out.size() << " in order\n";
+
+  std::cout << "--closed channel--\n";
+  int v = 1;
+  assert(!ch.try_push(v));
+  assert(!ch.try_pop());
+}
+
+void testAsyncChannelThreads() {
+  std::cout << "----Test AsyncChannel thread pool----\n";
+  std::atomic<long> sum = 0;
+  std::atomic<int> count = 0;
+  ThreadPoolExecutor ex(4);
+  AsyncChannel<int> ch(ex, 16);
+  const int producers = 100;
+  const int per_producer = 1000;
+  for (int i = 0; i != 8; ++i) ex.spawn(consumer(ch, sum, count));
+  for (int i = 0; i != producers; ++i) ex.spawn(producer(ch, 0, per_producer));
+  // consumers never finish on their own, wait until everything was delivered
+  while (count != producers * per_producer) std::this_thread::yield();
+  ch.close();
+  ex.wait_idle();
+  assert(sum == long(producers) * per_producer * (per_producer - 1) / 2);
+  std::cout << "received " << count << " values\n";
+}
+
+void testPersistentList() {
+  std::cout << "----Test PersistentList----\n";
+  PersistentList<int> l{1, 2, 3, 4};
+  PersistentList<int> snap = l.snapshot();
+  assert(snap.shares(l));
+
+  std::cout << "--push_front shares the whole old list--\n";
+  l.push_front(0);
+  assert(l.size() == 5 && snap.size() == 4);
+  assert(&*std::next(l.begin()) == &*snap.begin());
+
+  std::cout << "--insert and erase share the suffix--\n";
+  auto pos = std::next(l.begin(), 3);  // 3
+  const int* shared = &*std::next(pos);
+  auto it = l.insert(pos, 42);
+  assert(*it == 42 && *std::next(it) == 3);
+  assert(&*std::next(it, 2) == shared);
+  it = l.erase(std::next(l.begin()));  // 1
+  assert(*it == 2);
+  for (auto i = l.cbegin(); i != l.cend(); ++i) std::cout << *i << " ";
+  std::cout << "\n";
+  for (auto i = snap.cbegin(); i != snap.cend(); ++i) std::cout << *i << " ";
+  std::cout << "\n";
+  int expect = 1;
+  for (auto i = snap.cbegin(); i != snap.cend(); ++i) assert(*i == expect++);
+
+  std::cout << "--snapshots in worker threads--\n";
+  PersistentList<std::string> cfg;
+  for (int i = 0; i != 100; ++i) cfg.push_front(std::to_string(i));
+  std::vector<std::thread> workers;
+  std::atomic<size_t> total = 0;
+  for (int t = 0; t != 4; ++t) {
+    workers.emplace_back([s = cfg.snapshot(), &total] {
+      for (int r = 0; r != 1000; ++r) {
+        PersistentList<std::string> local = s;
+        local.pop_front();
+        total += local.size();
+      }
+    });
+  }
+  cfg.clear();
+  for (auto& w : workers) w.join();
+  assert(total == 4u * 1000u * 99u);
+}
+
+/// allocator without a default constructor, copies of a List must not need one
+template <class T>
+struct TaggedAlloc {
+  using value_type = T;
+  int tag;
+  explicit TaggedAlloc(int t) noexcept : tag(t) {}
+  template <class U>
+  TaggedAlloc(const TaggedAlloc<U>& other) noexcept : tag(other.tag) {}
+  T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T* ptr, std::size_t n) noexcept { std::allocator<T>().deallocate(ptr, n); }
+  template <class U>
+  bool operator==(const TaggedAlloc<U>& other) const noexcept {
+    return tag == other.tag;
+  }
+};
+
+void testHugePageArena() {
+  std::cout << "----Test HugePageArena----\n";
+  auto arena = std::make_shared<HugePageArena>();
+  HugePageAllocator<int> alloc(arena);
+  List<int, HugePageAllocator<int>> l(alloc);
+  const int n = 200000;  // a few chunks worth of nodes
+  for (int i = 0; i != n; ++i) l.push_back(i);
+  const size_t chunks = arena->chunks();
+  std::cout << "chunks " << chunks << " hugetlb " << arena->hugetlb_chunks() << "\n";
+  assert(chunks > 1);
+
+  std::cout << "--freed nodes are reused--\n";
+  for (auto it = l.begin(); it != l.end();) {
+    it = l.erase(it);
+    if (it != l.end()) ++it;
+  }
+  assert(l.size() == n / 2);
+  for (int i = 0; i != n / 2; ++i) l.push_front(-i);
+  assert(arena->chunks() == chunks);
+
+  std::cout << "--copy shares the arena--\n";
+  List<int, HugePageAllocator<int>> copy(l);
+  assert(copy.size() == l.size() && copy.back() == l.back());
+  assert(arena->chunks() > chunks);
+
+  std::cout << "--copy takes the allocator of the source--\n";
+  List<int, TaggedAlloc<int>> tagged(TaggedAlloc<int>(7));
+  for (int i = 0; i != 10; ++i) tagged.push_back(i);
+  List<int, TaggedAlloc<int>> tagged_copy(tagged);
+  assert(tagged_copy.size() == 10 && tagged_copy.back() == 9);
+
+  std::cout << "--oversize blocks bypass the chunks--\n";
+  const size_t before = arena->chunks();
+  void* big = arena->allocate(HugePageArena::max_slot * 4);
+  std::memset(big, 0, HugePageArena::max_slot * 4);
+  arena->deallocate(big, HugePageArena::max_slot * 4);
+  assert(arena->chunks() == before);
+}
+
+void testSortedList() {
+  std::cout << "----Test SortedList----\n";
+  SortedList<int> l;
+  std::vector<int> v;
+  std::mt19937 rng(7);
+  std::cout << "--near-monotonic insert--\n";
+  for (int i = 0; i != 1000; ++i) {
+    int deadline = i * 10 + static_cast<int>(rng() % 40) - 20;
+    l.insert(deadline);
+    v.push_back(deadline);
+  }
+  std::cout << "--random insert and erase--\n";
+  for (int i = 0; i != 500; ++i) {
+    int key = static_cast<int>(rng() % 10000);
+    l.insert(key);
+    v.push_back(key);
+  }
+  for (int i = 0; i != 200; ++i) {
+    auto it = l.find(static_cast<int>(rng() % 10000));
+    if (it == l.end()) continue;
+    v.erase(std::find(v.begin(), v.end(), *it));
+    l.erase(it);
+  }
+  std::sort(v.begin(), v.end());
+  assert(l.size() == v.size());
+  assert(std::equal(v.begin(), v.end(), l.begin()));
+
+  std::cout << "--lower_bound / upper_bound--\n";
+  for (int key = -50; key < 10100; key += 7) {
+    auto lo = l.lower_bound(key);
+    auto hi = l.upper_bound(key);
+    auto vlo = std::lower_bound(v.begin(), v.end(), key);
+    auto vhi = std::upper_bound(v.begin(), v.end(), key);
+    assert(std::distance(l.begin(), lo) == std::distance(v.begin(), vlo));
+    assert(std::distance(l.begin(), hi) == std::distance(v.begin(), vhi));
+  }
+
+  std::cout << "--far apart keys--\n";
+  SortedList<int> far;
+  for (int key : {0, INT_MAX, INT_MIN, -1, INT_MAX - 1, INT_MIN + 1}) far.insert(key);
+  assert(far.front() == INT_MIN && far.back() == INT_MAX);
+  assert(*far.find(INT_MAX - 1) == INT_MAX - 1 && *far.lower_bound(INT_MIN + 1) == INT_MIN + 1);
+  assert(far.find(1) == far.end());
+
+  std::cout << "--equal keys keep insertion order--\n";
+  SortedList<std::pair<int, int>, bool (*)(const std::pair<int, int>&, const std::pair<int, int>&)> s(
+      [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+  for (int i = 0; i != 10; ++i) s.insert(std::make_pair(i % 3, i));
+  for (auto it = s.begin(), next = std::next(it); next != s.end(); ++it, ++next) {
+    assert(it->first < next->first || (it->first == next->first && it->second < next->second));
+  }
+  std::cout << "front " << s.front().first << ":" << s.front().second << " back " << s.back().first << ":"
+            << s.back().second << "\n";
+}
+
+struct Counted {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  int v;
+  explicit Counted(int v = 0) : v(v) {}
+  Counted(const Counted& o) : v(o.v) { ++copies; }
+  Counted(Counted&& o) noexcept : v(o.v) { ++moves; }
+  Counted& operator=(const Counted&) = default;
+  Counted& operator=(Counted&&) = default;
+};
+
+void testMoveSwap() {
+  std::cout << "----Test move and swap----\n";
+  static_assert(std::is_nothrow_move_constructible_v<List<Counted>>);
+  static_assert(std::is_nothrow_move_assignable_v<List<Counted>>);
+  static_assert(std::is_nothrow_swappable_v<List<Counted>>);
+
+  std::cout << "--vector of lists reallocates without copies--\n";
+  std::vector<List<Counted>> v;
+  for (int i = 0; i != 100; ++i) {
+    v.emplace_back();
+    for (int j = 0; j != 10; ++j) v.back().emplace_back(j);
+  }
+  assert(Counted::copies == 0 && Counted::moves == 0);
+  assert(v.front().size() == 10 && v.front().back().v == 9);
+
+  std::cout << "--move ctor and move assign relink nodes--\n";
+  const Counted* node = &v[0].front();
+  List<Counted> moved(std::move(v[0]));
+  assert(v[0].empty() && moved.size() == 10 && &moved.front() == node);
+  v[0].emplace_back(1);  // moved-from list stays usable
+  v[1] = std::move(moved);
+  assert(moved.empty() && &v[1].front() == node);
+
+  std::cout << "--swap--\n";
+  List<Counted> empty;
+  swap(empty, v[1]);
+  assert(v[1].empty() && empty.size() == 10 && &empty.front() == node);
+  empty.swap(v[2]);
+  assert(empty.size() == 10 && v[2].size() == 10 && &v[2].front() == node);
+  int sum = 0;
+  for (auto it = v[2].cbegin(); it != v[2].cend(); ++it) sum += it->v;
+  for (auto it = v[2].rcbegin(); it != v[2].rcend(); ++it) sum -= it->v;
+  assert(sum == 0);
+  assert(Counted::copies == 0 && Counted::moves == 0);
+
+  std::cout << "--different allocators move element-wise--\n";
+  using ArenaList = List<Counted, HugePageAllocator<Counted>>;
+  ArenaList a{HugePageAllocator<Counted>()};
+  ArenaList b{HugePageAllocator<Counted>()};
+  for (int i = 0; i != 5; ++i) a.emplace_back(i);
+  b = std::move(a);
+  assert(a.empty() && b.size() == 5 && Counted::moves == 5);
+
+  std::cout << "--equal allocators relink--\n";
+  auto arena = std::make_shared<HugePageArena>();
+  ArenaList c{HugePageAllocator<Counted>(arena)};
+  ArenaList d{HugePageAllocator<Counted>(arena)};
+  c.emplace_back(1);
+  node = &c.front();
+  d = std::move(c);
+  assert(c.empty() && &d.front() == node && Counted::moves == 5);
+}
+
+void testRcuList() {
+  std::cout << "----Test RcuList----\n";
+  struct Route {
+    int prefix;
+    int version;
+  };
+  RcuList<Route> routes;
+  for (int i = 0; i != 32; ++i) routes.push_back(Route{i, 0});
+
+  std::atomic<bool> done = false;
+  std::atomic<long> reads = 0;
+  std::vector<std::thread> readers;
+  for (int t = 0; t != 4; ++t) {
+    readers.emplace_back([&] {
+      auto r = routes.reader();
+      while (!done) {
+        int last = -1;
+        r.for_each([&](const Route& route) {
+          assert(route.prefix > last || route.prefix == last);  // replaced entries may show twice
+          assert(route.version >= 0);
+          last = route.prefix;
+        });
+        ++reads;
+      }
+    });
+  }
+
+  std::cout << "--writer updates while readers traverse--\n";
+  for (int v = 1; v != 2000; ++v) {
+    const int prefix = v % 32;
+    routes.replace_if([&](const Route& r) { return r.prefix == prefix; }, Route{prefix, v});
+    if (v % 100 == 0) {
+      routes.erase_if([](const Route& r) { return r.prefix == 31; });
+      routes.push_back(Route{31, v});
+    }
+  }
+  done = true;
+  for (auto& t : readers) t.join();
+  routes.synchronize();
+  assert(routes.size() == 32);
+  std::cout << "readers finished " << (reads > 0 ? "some" : "no") << " traversals\n";
+
+  auto r = routes.reader();
+  int count = 0;
+  {
+    auto g = r.lock();
+    for (auto it = g.begin(); it != g.end(); ++it) ++count;
+  }
+  assert(count == 32);
+  routes.clear();
+  routes.synchronize();
+  assert(routes.empty());
+}
+
+void testTimingWheel() {
+  std::cout << "----Test TimingWheel----\n";
+  TimingWheel<> wheel(1000);
+  std::vector<std::uint64_t> fired_at;
+  std::vector<TimingWheel<>::TimerHandle> handles;
+  std::mt19937_64 rng(3);
+  std::vector<std::uint64_t> expiries;
+  // near, cascaded over one, two and three levels, and beyond the top level
+  const std::uint64_t ranges[] = {200, 60000, 10000000, 3000000000ull, 20000000000ull};
+  for (std::uint64_t range : ranges) {
+    for (int i = 0; i != 200; ++i) {
+      const std::uint64_t e = 1001 + rng() % range;
+      expiries.push_back(e);
+      handles.push_back(wheel.schedule(e, [&fired_at, &wheel, e] {
+        assert(e <= wheel.now());
+        fired_at.push_back(e);
+      }));
+    }
+  }
+  std::cout << "--cancel every third timer--\n";
+  std::vector<std::uint64_t> expect;
+  for (size_t i = 0; i != handles.size(); ++i) {
+    if (i % 3 == 0) {
+      wheel.cancel(handles[i]);
+    } else {
+      expect.push_back(expiries[i]);
+    }
+  }
+  assert(wheel.size() == expect.size());
+
+  std::cout << "--advance in uneven steps--\n";
+  std::uint64_t now = 1000;
+  std::uint64_t step = 1;
+  while (!wheel.empty()) {
+    const size_t before = fired_at.size();
+    const std::uint64_t prev = now;
+    now += step;
+    step = step * 3 + rng() % 7;
+    const size_t fired = wheel.advance(now);
+    assert(fired == fired_at.size() - before);
+    for (size_t i = before; i != fired_at.size(); ++i) assert(fired_at[i] > prev && fired_at[i] <= now);
+  }
+  std::sort(expect.begin(), expect.end());
+  assert(fired_at == expect);
+
+  std::cout << "--callbacks may rearm and cancel--\n";
+  TimingWheel<> w2;
+  int ticks = 0;
+  TimingWheel<>::TimerHandle victim = w2.schedule(5, [] { assert(false); });
+  std::function<void()> rearm = [&] {
+    if (++ticks < 10) w2.schedule_after(1, rearm);
+  };
+  w2.schedule(2, [&] { w2.cancel(victim); });
+  w2.schedule(1, rearm);
+  for (int t = 1; t != 20; ++t) w2.advance(t);
+  assert(ticks == 10 && w2.empty());
+
+  std::cout << "--due timers fire without moving the clock--\n";
+  TimingWheel<> w3(100);
+  std::vector<int> order;
+  w3.schedule(101, [&] { order.push_back(101); });
+  w3.schedule(w3.now(), [&] { order.push_back(100); });
+  w3.schedule(40, [&] { order.push_back(40); });
+  assert(w3.advance(w3.now()) == 2 && order == std::vector<int>({40, 100}));
+  assert(w3.advance(101) == 1 && order.back() == 101 && w3.empty());
+  w3.schedule(120, [&] { order.push_back(120); });
+  w3.schedule(90, [&] { order.push_back(90); });  // overdue one fires before the later one
+  assert(w3.advance(130) == 2 && order[3] == 90 && order[4] == 120);
+  std::cout << "fired " << fired_at.size() << " timers\n";
+}
+
+void testAdaptiveList() {
+  std::cout << "----Test AdaptiveList----\n";
+  AdaptivePolicy policy;
+  policy.window = 1000;
+  policy.min_size = 16;
+  AdaptiveList<int> l(policy);
+  std::list<int> mirror;
+  for (int i = 0; i != 100; ++i) {
+    l.push_back(i);
+    mirror.push_back(i);
+  }
+  assert(!l.is_contiguous());
+
+  std::cout << "--traversal heavy goes contiguous--\n";
+  long sum = 0;
+  for (int rep = 0; rep != 20; ++rep) {
+    for (auto it = l.cbegin(); it != l.cend(); ++it) sum += *it;
+  }
+  l.push_back(100);  // decisions are made in modifying calls only
+  mirror.push_back(100);
+  assert(l.is_contiguous() && sum == 20 * 4950);
+  assert(std::equal(mirror.begin(), mirror.end(), l.begin()));
+
+  std::cout << "--middle edits go linked--\n";
+  for (int i = 0; i != 1200; ++i) {
+    auto it = std::next(l.begin(), 3);
+    auto mit = std::next(mirror.begin(), 3);
+    if (i % 2) {
+      it = l.erase(it);
+      mit = mirror.erase(mit);
+    } else {
+      it = l.insert(it, -i);
+      mit = mirror.insert(mit, -i);
+    }
+    assert(*it == *mit);
+  }
+  assert(!l.is_contiguous());
+  assert(l.size() == mirror.size());
+  assert(std::equal(mirror.begin(), mirror.end(), l.begin()));
+
+  std::cout << "--mixed workload stays put--\n";
+  l.make_contiguous();
+  for (int i = 0; i != 3000; ++i) {
+    auto it = l.begin();
+    for (int j = 0; j != 40; ++j) ++it;  // 20 steps per edit, between the thresholds
+    l.insert(it, i);
+    l.pop_front();
+    assert(l.is_contiguous());
+  }
+  l.push_front(7);
+  assert(l.front() == 7 && *l.rbegin() == l.back());
+
+  std::cout << "--empty range erase--\n";
+  const auto size = l.size();
+  auto mid = std::next(l.cbegin(), 5);
+  assert(l.erase(mid, mid) == std::next(l.begin(), 5) && l.size() == size);
+  l.make_linked();
+  mid = std::next(l.cbegin(), 5);
+  assert(l.erase(mid, mid) == std::next(l.begin(), 5) && l.size() == size);
+  assert(l.erase(l.cend(), l.cend()) == l.end());
+}
+
+struct WorkItem {
+  int id;
+  double weight;
+  char tag[12];
+};
+
+struct Checked {
+  int v;
+  explicit Checked(int x) : v(x) {
+    if (x < 0) throw std::invalid_argument("negative");
+  }
+};
+
+void testShmList() {
+  std::cout << "----Test ShmList----\n";
+  const std::string name = "/list_test_" + std::to_string(::getpid());
+  ShmSegment::remove(name.c_str());
+  auto q = ShmList<WorkItem>::create(name.c_str(), 1 << 16);
+
+  std::cout << "--two mappings at different addresses--\n";
+  {
+    auto other = ShmList<WorkItem>::open(name.c_str());
+    other.push_back(WorkItem{1, 0.5, "one"});
+    other.emplace_back(WorkItem{2, 1.5, "two"});
+    assert(q.size() == 2);
+    auto a = q.try_pop_front();
+    assert(a && a->id == 1 && std::string(a->tag) == "one");
+    assert(q.try_consume_front([](const WorkItem& w) { assert(w.id == 2 && w.weight == 1.5); }));
+    assert(!q.try_pop_front() && other.empty());
+  }
+
+  std::cout << "--producer process--\n";
+  constexpr int n = 20000;  // more than fit at once, nodes must be recycled
+  const pid_t pid = ::fork();
+  assert(pid >= 0);
+  if (pid == 0) {
+    auto producer = ShmList<WorkItem>::open(name.c_str());
+    for (int i = 0; i != n; ++i) {
+      while (producer.size() > 256) ::sched_yield();
+      producer.emplace_back(WorkItem{i, i * 0.25, "item"});
+    }
+    producer.close();
+    ::_exit(0);
+  }
+  int expected = 0;
+  while (q.consume_front([&](const WorkItem& w) { assert(w.id == expected && w.weight == expected * 0.25); })) {
+    ++expected;
+  }
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  assert(expected == n && q.empty());
+  ShmSegment::remove(name.c_str());
+
+  std::cout << "--failed setup and foreign segments--\n";
+  const std::string other = name + "_b";
+  try {
+    ShmSegment::create(other.c_str(), 4096, [](ShmSegment&) { throw std::runtime_error("init"); });
+    assert(false);
+  } catch (const std::runtime_error& e) {
+    assert(std::string(e.what()) == "init");
+  }
+  try {
+    ShmSegment::open(other.c_str());  // the name was removed again
+    assert(false);
+  } catch (const std::system_error& e) {
+    assert(e.code().value() == ENOENT);
+  }
+  {
+    ShmSegment plain = ShmSegment::create(other.c_str(), 4096);
+    try {
+      ShmList<WorkItem>::open(other.c_str());
+      assert(false);
+    } catch (const std::system_error& e) {
+      assert(e.code().value() == EINVAL);
+    }
+  }
+  ShmSegment::remove(other.c_str());
+
+  std::cout << "--throwing constructor--\n";
+  auto checked = ShmList<Checked>::create(other.c_str(), 4096);
+  ShmSegment::remove(other.c_str());
+  for (int i = 0; i != 1000; ++i) {  // leaked nodes would exhaust the segment
+    try {
+      checked.emplace_back(-1);
+      assert(false);
+    } catch (const std::invalid_argument&) {
+    }
+  }
+  checked.emplace_back(3);
+  assert(checked.size() == 1 && checked.try_pop_front()->v == 3);
+}
+
+void testNodeCache() {
+  std::cout << "----Test NodeCache----\n";
+  using CachedList = List<int, NodeCacheAllocator<int>>;
+  using Cache = NodeCache<sizeof(_priv::Node<int>), alignof(_priv::Node<int>)>;
+
+  std::cout << "--same thread--\n";
+  {
+    CachedList l;
+    for (int i = 0; i != 10000; ++i) l.push_back(i);
+    for (int i = 0; i != 5000; ++i) l.pop_front();
+    CachedList copy(l);
+    assert(copy.size() == 5000 && copy.front() == 5000 && copy.back() == 9999);
+  }
+  const std::size_t slabs = Cache::slabs();
+
+  std::cout << "--producer/consumer threads--\n";
+  std::mutex mtx;
+  CachedList shared;
+  std::atomic<bool> done = false;
+  long long consumed = 0;
+  std::thread consumer([&] {
+    CachedList mine;
+    for (;;) {
+      const bool last = done;  // read before the splice, the final batch is in shared by then
+      {
+        std::lock_guard lock(mtx);
+        mine.splice(mine.end(), shared);
+      }
+      if (mine.empty() && last) break;
+      while (!mine.empty()) {
+        consumed += mine.front();
+        mine.pop_front();  // frees a node of the producer thread
+      }
+      std::this_thread::yield();
+    }
+  });
+  std::thread producer([&] {
+    long long expected = 0;
+    for (int round = 0; round != 300; ++round) {
+      CachedList batch;
+      for (int i = 0; i != 500; ++i) batch.push_back(i);
+      expected += 500LL * 499 / 2;
+      std::unique_lock lock(mtx);
+      while (shared.size() > 1000) {  // keep the consumer close behind
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+      }
+      shared.splice(shared.end(), batch);
+    }
+    assert(expected == 300LL * 500 * 499 / 2);
+    done = true;
+  });
+  producer.join();
+  consumer.join();
+  assert(consumed == 300LL * 500 * 499 / 2);
+  // 150000 nodes went through, returned nodes were reused instead of new slabs
+  assert(Cache::slabs() - slabs < 20);
+
+  std::cout << "--cache of an exited thread is adopted--\n";
+  const std::size_t before = Cache::slabs();
+  for (int t = 0; t != 8; ++t) {
+    std::thread([] {
+      CachedList l;
+      for (int i = 0; i != 1000; ++i) l.push_back(i);
+    }).join();
+  }
+  assert(Cache::slabs() - before <= 1);
+}
+
 int main() {
   std::cout << "------start test------\n";
   try {
@@ -251,6 +901,17 @@ int main() {
     testErase();
     testEmplace();
     testInsertIt();
+    testAsyncChannel();
+    testAsyncChannelThreads();
+    testPersistentList();
+    testHugePageArena();
+    testSortedList();
+    testMoveSwap();
+    testRcuList();
+    testTimingWheel();
+    testAdaptiveList();
+    testShmList();
+    testNodeCache();
 
   } catch (const std::exception& e) {
     std::cerr << e.what() << '\n';